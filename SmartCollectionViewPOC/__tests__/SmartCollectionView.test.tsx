@@ -0,0 +1,101 @@
+/**
+ * @format
+ */
+
+import 'react-native';
+import React from 'react';
+import {Text} from 'react-native';
+import SmartCollectionView from '../src/components/SmartCollectionView';
+
+// Note: import explicitly to use the types shiped with jest.
+import {describe, expect, it} from '@jest/globals';
+
+// Note: test renderer must be required after react-native.
+import renderer, {act, ReactTestRenderer} from 'react-test-renderer';
+
+const data = Array.from({length: 30}, (_, index) => ({id: `item-${index}`}));
+
+const renderList = (): ReactTestRenderer => {
+  let tree: ReactTestRenderer | undefined;
+  act(() => {
+    tree = renderer.create(
+      <SmartCollectionView
+        data={data}
+        initialNumToRender={5}
+        renderItem={({item}) => <Text>{item.id}</Text>}
+      />,
+    );
+  });
+  return tree!;
+};
+
+// requireNativeComponent renders host elements named after the native view
+const nativeList = (tree: ReactTestRenderer) =>
+  tree.root.find(node => node.type === 'SmartCollectionView');
+
+const renderedIndices = (tree: ReactTestRenderer) =>
+  tree.root
+    .findAll(node => node.type === 'SmartCollectionViewItem')
+    .map(node => node.props.itemIndex);
+
+const requestItems = (tree: ReactTestRenderer, indices: number[], generation: number) =>
+  nativeList(tree).props.onRequestItems({nativeEvent: {indices, generation}});
+
+const cancelRequests = (tree: ReactTestRenderer, indices: number[], generation: number) =>
+  nativeList(tree).props.onCancelRequests({nativeEvent: {indices, generation}});
+
+describe('SmartCollectionView', () => {
+  it('tags each item with its data index', () => {
+    const tree = renderList();
+    expect(renderedIndices(tree)).toEqual([0, 1, 2, 3, 4]);
+
+    act(() => requestItems(tree, [12, 10], 1));
+    expect(renderedIndices(tree)).toEqual([0, 1, 2, 3, 4, 10, 12]);
+  });
+
+  it('acknowledges the latest rendered request generation', () => {
+    const tree = renderList();
+    expect(nativeList(tree).props.acknowledgedGeneration).toBe(0);
+
+    act(() => requestItems(tree, [10, 11], 3));
+    expect(nativeList(tree).props.acknowledgedGeneration).toBe(3);
+
+    // A late, older batch still renders but never moves the acknowledgement back
+    act(() => requestItems(tree, [12], 2));
+    expect(nativeList(tree).props.acknowledgedGeneration).toBe(3);
+    expect(renderedIndices(tree)).toContain(12);
+  });
+
+  it('drops cancelled indices that have not rendered yet', () => {
+    const tree = renderList();
+
+    // Requested and cancelled before React committed the batch
+    act(() => {
+      requestItems(tree, [20, 21], 1);
+      cancelRequests(tree, [20], 1);
+    });
+    expect(renderedIndices(tree)).toEqual([0, 1, 2, 3, 4, 21]);
+  });
+
+  it('keeps cancelled indices that native already placed', () => {
+    const tree = renderList();
+    act(() => requestItems(tree, [20, 21], 1));
+
+    act(() => cancelRequests(tree, [3, 20], 1));
+    expect(renderedIndices(tree)).toEqual([0, 1, 2, 3, 4, 20, 21]);
+  });
+
+  it('remounts a committed index that native requests again', () => {
+    const tree = renderList();
+    const itemAt = (index: number) =>
+      tree.root.find(node => node.type === 'SmartCollectionViewItem' && node.props.itemIndex === index);
+    const lost = itemAt(3);
+    const kept = itemAt(2);
+
+    // The request for 3 expired without its child registering, so native retries it
+    act(() => requestItems(tree, [3], 2));
+    expect(renderedIndices(tree)).toEqual([0, 1, 2, 3, 4]);
+    expect(itemAt(3)).not.toBe(lost);
+    expect(itemAt(2)).toBe(kept);
+  });
+});
@@ -0,0 +1,17 @@
+#import "SmartCollectionViewLayoutProvider.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+// rowCount rows scrolling horizontally, filled column by column: item i sits
+// in column i / rowCount, row i % rowCount. A column is as wide as its widest
+// item and every row as tall as the tallest item. Column widths live in an
+// offset index, so a resize and offset->column lookups are O(log n) and
+// index->frame is O(log n) with no per-item state beyond the raw widths.
+@interface HorizontalGridLayoutProvider : NSObject <SmartCollectionViewLayoutProvider>
+
+@property (nonatomic, assign) NSInteger rowCount;       // Re-run prepareWithSizes after changing (default: 2)
+@property (nonatomic, assign) CGSize estimatedItemSize; // Used for zero sizes (default: 100x80)
+
+@end
+
+NS_ASSUME_NONNULL_END
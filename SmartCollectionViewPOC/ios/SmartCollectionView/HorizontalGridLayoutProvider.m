@@ -0,0 +1,174 @@
+#import "HorizontalGridLayoutProvider.h"
+#import "SmartCollectionViewOffsetIndex.h"
+#import "SmartCollectionViewMaxTree.h"
+#import <stdlib.h>
+#import <math.h>
+
+@implementation HorizontalGridLayoutProvider
+{
+    CGFloat *_itemWidths;  // resolved width per item; a column's width is the max of its rowCount entries
+    NSInteger _capacity;
+    NSInteger _itemCount;
+    NSInteger _rows;       // rowCount captured by the last prepare
+    SmartCollectionViewOffsetIndex *_columns; // column widths along x
+    SmartCollectionViewMaxTree *_heights;
+}
+
+- (instancetype)init
+{
+    self = [super init];
+    if (self) {
+        _rowCount = 2;
+        _estimatedItemSize = CGSizeMake(100, 80);
+        _itemWidths = NULL;
+        _capacity = 0;
+        _itemCount = 0;
+        _rows = 2;
+        _columns = [[SmartCollectionViewOffsetIndex alloc] init];
+        _heights = [[SmartCollectionViewMaxTree alloc] init];
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    free(_itemWidths);
+}
+
+- (NSString *)layoutType {
+    return @"horizontalGrid";
+}
+
+- (NSInteger)itemCount
+{
+    return _itemCount;
+}
+
+- (CGSize)resolvedSize:(CGSize)size
+{
+    if (size.width <= 0 || size.height <= 0) {
+        return _estimatedItemSize;
+    }
+    return size;
+}
+
+- (CGFloat)widthOfColumn:(NSInteger)column
+{
+    NSInteger start = column * _rows;
+    NSInteger end = MIN(start + _rows, _itemCount);
+    CGFloat width = 0;
+    for (NSInteger i = start; i < end; i++) {
+        width = MAX(width, _itemWidths[i]);
+    }
+    return width;
+}
+
+#pragma mark - Sizes
+
+- (void)prepareWithSizes:(const CGSize *)sizes count:(NSInteger)count viewport:(CGSize)viewport
+{
+    count = MAX(0, count);
+    if (count > _capacity) {
+        _capacity = MAX(count, MAX(64, _capacity * 2));
+        _itemWidths = realloc(_itemWidths, sizeof(CGFloat) * _capacity);
+    }
+    _itemCount = count;
+    _rows = MAX(1, _rowCount);
+
+    CGFloat *heights = malloc(sizeof(CGFloat) * MAX(count, 1));
+    for (NSInteger i = 0; i < count; i++) {
+        CGSize size = [self resolvedSize:sizes[i]];
+        _itemWidths[i] = size.width;
+        heights[i] = size.height;
+    }
+    [_heights resetWithValues:heights count:count];
+    free(heights);
+
+    NSInteger columnCount = (count + _rows - 1) / _rows;
+    CGFloat *columnWidths = malloc(sizeof(CGFloat) * MAX(columnCount, 1));
+    for (NSInteger column = 0; column < columnCount; column++) {
+        columnWidths[column] = [self widthOfColumn:column];
+    }
+    [_columns resetWithLengths:columnWidths count:columnCount];
+    free(columnWidths);
+}
+
+- (BOOL)setSize:(CGSize)size atIndex:(NSInteger)index
+{
+    if (index < 0 || index >= _itemCount) {
+        return NO;
+    }
+    size = [self resolvedSize:size];
+    CGFloat previousRowHeight = _heights.maxValue;
+    [_heights setValue:size.height atIndex:index];
+
+    // O(rowCount) to refresh the column's max, then O(log n) to shift later columns
+    BOOL changed = NO;
+    if (_itemWidths[index] != size.width) {
+        _itemWidths[index] = size.width;
+        NSInteger column = index / _rows;
+        changed = [_columns setLength:[self widthOfColumn:column] atIndex:column];
+    }
+    return changed || _heights.maxValue != previousRowHeight;
+}
+
+#pragma mark - Queries
+
+- (CGSize)contentSize
+{
+    if (_itemCount == 0) {
+        return CGSizeZero;
+    }
+    return CGSizeMake(_columns.totalLength, MIN(_rows, _itemCount) * _heights.maxValue);
+}
+
+- (CGRect)frameForItemAtIndex:(NSInteger)index
+{
+    if (index < 0 || index >= _itemCount) {
+        return CGRectNull;
+    }
+    NSInteger column = index / _rows;
+    NSInteger row = index % _rows;
+    CGFloat rowHeight = _heights.maxValue;
+    return CGRectMake([_columns offsetAtIndex:column], row * rowHeight, [_columns lengthAtIndex:column], rowHeight);
+}
+
+- (void)enumerateItemsInRect:(CGRect)rect
+                  usingBlock:(void (NS_NOESCAPE ^)(NSInteger index, CGRect frame, BOOL *stop))block
+{
+    CGFloat rowHeight = _heights.maxValue;
+    if (_itemCount == 0 || rowHeight <= 0 || CGRectIsNull(rect)) {
+        return;
+    }
+
+    // Rows are uniform, so the row span is O(1)
+    NSInteger firstRow = MAX(0, (NSInteger)floor(CGRectGetMinY(rect) / rowHeight));
+    NSInteger lastRow = MIN(MIN(_rows, _itemCount) - 1, (NSInteger)ceil(CGRectGetMaxY(rect) / rowHeight) - 1);
+    if (firstRow > lastRow) {
+        return;
+    }
+
+    // O(log n) to the first column, then O(rowCount) per column walking along x
+    NSInteger columnCount = _columns.count;
+    CGFloat maxX = CGRectGetMaxX(rect);
+    NSInteger column = [_columns indexForOffset:CGRectGetMinX(rect)];
+    CGFloat x = column < columnCount ? [_columns offsetAtIndex:column] : 0;
+    BOOL stop = NO;
+    while (column < columnCount && x < maxX) {
+        CGFloat width = [_columns lengthAtIndex:column];
+        for (NSInteger row = firstRow; row <= lastRow; row++) {
+            NSInteger index = column * _rows + row;
+            if (index >= _itemCount) {
+                break;
+            }
+            block(index, CGRectMake(x, row * rowHeight, width, rowHeight), &stop);
+            if (stop) {
+                return;
+            }
+        }
+        x += width;
+        column++;
+    }
+}
+
+@end
@@ -1,9 +0,0 @@
-#import "SmartCollectionViewLayoutProvider.h"
-
-NS_ASSUME_NONNULL_BEGIN
-
-@interface HorizontalListLayoutProvider : NSObject <SmartCollectionViewLayoutProvider>
-
-@end
-
-NS_ASSUME_NONNULL_END
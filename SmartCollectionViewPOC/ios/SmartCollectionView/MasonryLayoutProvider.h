@@ -0,0 +1,20 @@
+#import "SmartCollectionViewLayoutProvider.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+// Vertical waterfall: each item goes to the currently shortest column and
+// keeps that column for life. Column heights sit in a min-heap, so placing
+// an item is O(log c); each column keeps an offset index over its own items,
+// so a rect query is O(c log n + k) and a resize only shifts the items below
+// it in the same column. Appending never moves items already placed.
+// Columns are derived from the viewport width like VerticalGridLayoutProvider.
+@interface MasonryLayoutProvider : NSObject <SmartCollectionViewLayoutProvider>
+
+@property (nonatomic, assign) CGFloat minimumItemWidth;  // Re-run prepareWithSizes after changing (default: 100)
+@property (nonatomic, assign) CGSize estimatedItemSize;  // Used for zero sizes (default: 100x80)
+@property (nonatomic, assign, readonly) NSInteger columnCount;
+@property (nonatomic, assign, readonly) CGFloat columnWidth;
+
+@end
+
+NS_ASSUME_NONNULL_END
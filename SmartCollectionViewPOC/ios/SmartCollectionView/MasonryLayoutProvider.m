@@ -0,0 +1,261 @@
+#import "MasonryLayoutProvider.h"
+#import "SmartCollectionViewOffsetIndex.h"
+#import <stdlib.h>
+#import <math.h>
+
+// Item indices of one column, top to bottom
+typedef struct {
+    NSInteger *items;
+    NSInteger count;
+    NSInteger capacity;
+} SCVMasonryColumn;
+
+@implementation MasonryLayoutProvider
+{
+    NSInteger *_itemColumns;  // column of each item
+    NSInteger *_itemSlots;    // position of each item within its column
+    NSInteger _capacity;
+    NSInteger _itemCount;
+    CGFloat _width;           // viewport width captured by the last prepare
+
+    SCVMasonryColumn *_columns;
+    NSArray<SmartCollectionViewOffsetIndex *> *_columnOffsets; // item heights per column
+    NSInteger *_heap;          // column indices, shortest column first
+    NSInteger *_heapPositions; // heap slot of each column
+}
+
+- (instancetype)init
+{
+    self = [super init];
+    if (self) {
+        _minimumItemWidth = 100;
+        _estimatedItemSize = CGSizeMake(100, 80);
+        _itemColumns = NULL;
+        _itemSlots = NULL;
+        _capacity = 0;
+        _itemCount = 0;
+        _width = 0;
+        _columnCount = 0;
+        _columnWidth = 0;
+        _columns = NULL;
+        _columnOffsets = @[];
+        _heap = NULL;
+        _heapPositions = NULL;
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    [self freeColumns];
+    free(_itemColumns);
+    free(_itemSlots);
+}
+
+- (void)freeColumns
+{
+    for (NSInteger c = 0; c < _columnCount; c++) {
+        free(_columns[c].items);
+    }
+    free(_columns);
+    free(_heap);
+    free(_heapPositions);
+    _columns = NULL;
+    _heap = NULL;
+    _heapPositions = NULL;
+}
+
+- (NSString *)layoutType {
+    return @"masonry";
+}
+
+- (NSInteger)itemCount
+{
+    return _itemCount;
+}
+
+- (CGFloat)resolvedHeight:(CGSize)size
+{
+    return size.height > 0 ? size.height : _estimatedItemSize.height;
+}
+
+#pragma mark - Column heap
+
+- (BOOL)column:(NSInteger)a isShorterThan:(NSInteger)b
+{
+    CGFloat heightA = _columnOffsets[a].totalLength;
+    CGFloat heightB = _columnOffsets[b].totalLength;
+    // Ties go to the leftmost column so rows fill left to right
+    return heightA < heightB || (heightA == heightB && a < b);
+}
+
+- (void)swapHeapSlot:(NSInteger)i withSlot:(NSInteger)j
+{
+    NSInteger column = _heap[i];
+    _heap[i] = _heap[j];
+    _heap[j] = column;
+    _heapPositions[_heap[i]] = i;
+    _heapPositions[_heap[j]] = j;
+}
+
+// Restores heap order after a column's height changed, O(log c)
+- (void)siftColumn:(NSInteger)column
+{
+    NSInteger slot = _heapPositions[column];
+    while (slot > 0) {
+        NSInteger parent = (slot - 1) / 2;
+        if (![self column:_heap[slot] isShorterThan:_heap[parent]]) {
+            break;
+        }
+        [self swapHeapSlot:slot withSlot:parent];
+        slot = parent;
+    }
+    while (YES) {
+        NSInteger shortest = slot;
+        NSInteger left = 2 * slot + 1;
+        NSInteger right = left + 1;
+        if (left < _columnCount && [self column:_heap[left] isShorterThan:_heap[shortest]]) {
+            shortest = left;
+        }
+        if (right < _columnCount && [self column:_heap[right] isShorterThan:_heap[shortest]]) {
+            shortest = right;
+        }
+        if (shortest == slot) {
+            break;
+        }
+        [self swapHeapSlot:slot withSlot:shortest];
+        slot = shortest;
+    }
+}
+
+#pragma mark - Sizes
+
+- (void)prepareWithSizes:(const CGSize *)sizes count:(NSInteger)count viewport:(CGSize)viewport
+{
+    [self freeColumns];
+
+    // Before the first layout there is no width; lay out a single column of estimated width
+    _width = viewport.width > 0 ? viewport.width : _estimatedItemSize.width;
+    _columnCount = MAX(1, (NSInteger)floor(_width / MAX(1, _minimumItemWidth)));
+    _columnWidth = _width / _columnCount;
+
+    _columns = calloc(_columnCount, sizeof(SCVMasonryColumn));
+    _heap = malloc(sizeof(NSInteger) * _columnCount);
+    _heapPositions = malloc(sizeof(NSInteger) * _columnCount);
+    NSMutableArray<SmartCollectionViewOffsetIndex *> *columnOffsets = [NSMutableArray arrayWithCapacity:_columnCount];
+    for (NSInteger c = 0; c < _columnCount; c++) {
+        [columnOffsets addObject:[[SmartCollectionViewOffsetIndex alloc] init]];
+        _heap[c] = c; // All columns empty: index order is already a valid heap
+        _heapPositions[c] = c;
+    }
+    _columnOffsets = columnOffsets;
+
+    _itemCount = 0;
+    [self appendSizes:sizes count:count];
+}
+
+- (void)appendSizes:(const CGSize *)sizes count:(NSInteger)count
+{
+    if (count <= 0) {
+        return;
+    }
+    if (_columnCount == 0) {
+        [self prepareWithSizes:sizes count:count viewport:CGSizeZero];
+        return;
+    }
+    NSInteger total = _itemCount + count;
+    if (total > _capacity) {
+        _capacity = MAX(total, MAX(64, _capacity * 2));
+        _itemColumns = realloc(_itemColumns, sizeof(NSInteger) * _capacity);
+        _itemSlots = realloc(_itemSlots, sizeof(NSInteger) * _capacity);
+    }
+
+    for (NSInteger i = 0; i < count; i++) {
+        NSInteger index = _itemCount + i;
+        NSInteger c = _heap[0];
+        SCVMasonryColumn *column = &_columns[c];
+        if (column->count == column->capacity) {
+            column->capacity = MAX(16, column->capacity * 2);
+            column->items = realloc(column->items, sizeof(NSInteger) * column->capacity);
+        }
+        column->items[column->count] = index;
+        _itemColumns[index] = c;
+        _itemSlots[index] = column->count;
+        column->count++;
+
+        [_columnOffsets[c] appendLength:[self resolvedHeight:sizes[i]]];
+        [self siftColumn:c];
+    }
+    _itemCount = total;
+}
+
+- (BOOL)setSize:(CGSize)size atIndex:(NSInteger)index
+{
+    if (index < 0 || index >= _itemCount) {
+        return NO;
+    }
+    // Placement is fixed once made; a resize only moves the items below it in its column
+    NSInteger c = _itemColumns[index];
+    if (![_columnOffsets[c] setLength:[self resolvedHeight:size] atIndex:_itemSlots[index]]) {
+        return NO;
+    }
+    [self siftColumn:c];
+    return YES;
+}
+
+#pragma mark - Queries
+
+- (CGSize)contentSize
+{
+    if (_itemCount == 0) {
+        return CGSizeZero;
+    }
+    CGFloat height = 0;
+    for (SmartCollectionViewOffsetIndex *offsets in _columnOffsets) {
+        height = MAX(height, offsets.totalLength);
+    }
+    return CGSizeMake(_width, height);
+}
+
+- (CGRect)frameForItemAtIndex:(NSInteger)index
+{
+    if (index < 0 || index >= _itemCount) {
+        return CGRectNull;
+    }
+    NSInteger c = _itemColumns[index];
+    NSInteger slot = _itemSlots[index];
+    SmartCollectionViewOffsetIndex *offsets = _columnOffsets[c];
+    return CGRectMake(c * _columnWidth, [offsets offsetAtIndex:slot], _columnWidth, [offsets lengthAtIndex:slot]);
+}
+
+// Visits column by column, so indices come in order within a column only
+- (void)enumerateItemsInRect:(CGRect)rect
+                  usingBlock:(void (NS_NOESCAPE ^)(NSInteger index, CGRect frame, BOOL *stop))block
+{
+    if (_itemCount == 0 || _columnWidth <= 0 || CGRectIsNull(rect)) {
+        return;
+    }
+
+    NSInteger firstColumn = MAX(0, (NSInteger)floor(CGRectGetMinX(rect) / _columnWidth));
+    NSInteger lastColumn = MIN(_columnCount - 1, (NSInteger)ceil(CGRectGetMaxX(rect) / _columnWidth) - 1);
+    CGFloat maxY = CGRectGetMaxY(rect);
+    BOOL stop = NO;
+    for (NSInteger c = firstColumn; c <= lastColumn; c++) {
+        SmartCollectionViewOffsetIndex *offsets = _columnOffsets[c];
+        SCVMasonryColumn column = _columns[c];
+        // O(log n) to the first item of this column, then O(1) per item walking down
+        NSInteger slot = [offsets indexForOffset:CGRectGetMinY(rect)];
+        CGFloat y = slot < column.count ? [offsets offsetAtIndex:slot] : 0;
+        while (slot < column.count && y < maxY) {
+            CGFloat height = [offsets lengthAtIndex:slot];
+            block(column.items[slot], CGRectMake(c * _columnWidth, y, _columnWidth, height), &stop);
+            if (stop) {
+                return;
+            }
+            y += height;
+            slot++;
+        }
+    }
+}
+
+@end
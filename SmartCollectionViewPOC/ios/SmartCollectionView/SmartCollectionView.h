@@ -6,6 +6,15 @@
 @class SmartCollectionViewMountController;
 @class SmartCollectionViewEventBus;
 @class SmartCollectionViewScheduler;
+@class SmartCollectionViewOffsetIndex;
+@class SmartCollectionViewBatchController;
+@class SmartCollectionViewCreditController;
+@class SmartCollectionViewMountPolicy;
+@class SmartCollectionViewKeyedSizeCache;
+@class SmartCollectionViewPersistentSizeCache;
+@class SmartCollectionViewSizeEstimator;
+@class SmartCollectionViewSectionIndex;
+@protocol SmartCollectionViewLayoutProvider;
 
 @interface SmartCollectionView : RCTView <UIScrollViewDelegate>
 
@@ -15,6 +24,23 @@
 @property (nonatomic, assign) NSInteger overscanCount;
 @property (nonatomic, assign) CGFloat overscanLength;
 @property (nonatomic, assign) CGFloat shadowBufferMultiplier; // Multiplier for request range beyond mount range (default: 2.0)
+@property (nonatomic, assign) BOOL predictiveWindowing; // Skew mount/request windows toward the scroll direction (default: NO)
+@property (nonatomic, assign) NSInteger maxVisibleRequestsPerBatch; // Per-batch cap for visible items (default: 0 = no lane cap)
+@property (nonatomic, assign) NSInteger maxMountBufferRequestsPerBatch; // Per-batch cap for mount-buffer items (default: 0 = no lane cap)
+@property (nonatomic, assign) NSInteger maxShadowRequestsPerBatch; // Per-batch cap for shadow-buffer items (default: 0 = no lane cap)
+@property (nonatomic, assign) BOOL adaptiveBatching; // Size batches from measured mount cost instead of maxToRenderPerBatch (default: NO)
+@property (nonatomic, assign) CGFloat frameBudget; // Milliseconds of mount work per frame in adaptive mode (default: 4)
+@property (nonatomic, copy) NSArray<NSString *> *itemTypes; // Per-index item type from getItemType; keys the cost model
+@property (nonatomic, copy) NSArray<NSString *> *itemKeys; // Per-index key from keyExtractor; measured sizes and mounted views follow keys
+@property (nonatomic, copy) NSString *persistentSizeCacheName; // Keeps keyed sizes on disk across launches under this name (default: nil = off)
+@property (nonatomic, assign) BOOL adaptiveShadowBuffer; // Size the leading shadow buffer from measured JS render latency (default: NO)
+@property (nonatomic, assign) NSInteger maxOutstandingRequests; // Requested-but-unrendered items allowed at once (default: 0 = no flow control)
+@property (nonatomic, assign) NSInteger acknowledgedGeneration; // Latest onRequestItems generation JS has rendered
+@property (nonatomic, assign) CGFloat unmountDwellTime; // Milliseconds an item stays outside the exit band before unmounting (default: 0)
+// Layout cache budgets per tier in KB; frames over budget are evicted behind the scroll first (default: 0 = unlimited)
+@property (nonatomic, assign) NSInteger visibleLayoutCacheBudget;
+@property (nonatomic, assign) NSInteger bufferLayoutCacheBudget;
+@property (nonatomic, assign) NSInteger coldLayoutCacheBudget;
 
 // Initial mount optimization (optional, overrides main props during initial mount)
 @property (nonatomic, assign) NSInteger initialMaxToRenderPerBatch; // Default: 0 (use maxToRenderPerBatch)
@@ -23,11 +49,16 @@
 @property (nonatomic, assign) CGFloat initialShadowBufferMultiplier; // Default: 0 (use shadowBufferMultiplier)
 
 @property (nonatomic, assign) BOOL horizontal;
+@property (nonatomic, copy) NSString *layoutType; // "list", "grid" or "masonry" (vertical only) (default: "list")
+@property (nonatomic, assign) NSInteger rowCount; // Rows of a horizontal grid (default: 2)
+@property (nonatomic, copy) NSArray<NSNumber *> *stickyHeaderIndices; // Items that start a section and pin to the leading edge while it scrolls past; lists only (default: nil)
+@property (nonatomic, assign) CGFloat minimumItemWidth; // Vertical grids and masonry fit as many columns of this width as they can (default: 0 = estimatedItemSize.width)
 @property (nonatomic, assign) CGSize estimatedItemSize;
 @property (nonatomic, assign) NSInteger totalItemCount;
 
 // Events
 @property (nonatomic, copy) RCTDirectEventBlock onRequestItems;
+@property (nonatomic, copy) RCTDirectEventBlock onCancelRequests;
 @property (nonatomic, copy) RCTDirectEventBlock onVisibleRangeChange;
 @property (nonatomic, copy) RCTDirectEventBlock onScroll;
 @property (nonatomic, copy) RCTDirectEventBlock onScrollBeginDrag;
@@ -42,7 +73,15 @@
 
 // Data and layout
 @property (nonatomic, strong, readonly) NSMutableArray<UIView *> *virtualItems;
-@property (nonatomic, strong, readonly) NSMutableArray<NSNumber *> *cumulativeOffsets;
+@property (nonatomic, strong, readonly) SmartCollectionViewOffsetIndex *offsetIndex; // Prefix offsets along the scroll axis
+@property (nonatomic, strong, readonly) SmartCollectionViewBatchController *batchController; // Used when adaptiveBatching is on
+@property (nonatomic, strong, readonly) SmartCollectionViewCreditController *creditController; // Used when maxOutstandingRequests > 0
+@property (nonatomic, strong, readonly) SmartCollectionViewMountPolicy *mountPolicy; // Mount/unmount hysteresis for updateVisibleItems
+@property (nonatomic, strong, readonly) SmartCollectionViewKeyedSizeCache *keyedSizeCache; // Measured sizes by item key, used when itemKeys is set
+@property (nonatomic, strong, readonly) SmartCollectionViewPersistentSizeCache *persistentSizeCache; // Set when persistentSizeCacheName is
+@property (nonatomic, strong, readonly) SmartCollectionViewSizeEstimator *sizeEstimator; // Learned sizes for unmeasured items, per type and width
+@property (nonatomic, strong, readonly) SmartCollectionViewSectionIndex *sectionIndex; // Sections started by stickyHeaderIndices
+@property (nonatomic, strong, readonly) id<SmartCollectionViewLayoutProvider> layoutProvider; // Frames for grid layouts; nil for lists
 @property (nonatomic, assign, readonly) NSRange lastComputedRange;
 @property (nonatomic, assign, readonly) BOOL needsFullRecompute;
 @property (nonatomic, strong, readonly) SmartCollectionViewLayoutCache *layoutCache;
@@ -52,7 +91,7 @@
 @property (nonatomic, strong, readonly) SmartCollectionViewScheduler *scheduler;
 
 // Mounting state
-@property (nonatomic, strong, readonly) NSMutableSet<NSNumber *> *mountedIndices;
+@property (nonatomic, strong, readonly) NSMutableIndexSet *mountedIndices;
 @property (nonatomic, assign, readonly) NSInteger mountedCount;
 
 // Scroll tracking
@@ -60,10 +99,12 @@
 @property (nonatomic, assign, readonly) CGSize contentSize;
 
 // Methods
-- (void)addVirtualItem:(UIView *)item atIndex:(NSInteger)index;
+- (void)addVirtualItem:(UIView *)item;
 - (void)removeVirtualItem:(UIView *)item;
-- (void)registerChildView:(UIView *)view atIndex:(NSInteger)index;
+// Children are SmartCollectionViewItemViews and are placed at their itemIndex, never by position
+- (void)registerChildView:(UIView *)view;
 - (void)unregisterChildView:(UIView *)view;
+- (void)childView:(UIView *)view didMoveFromIndex:(NSInteger)previousIndex;
 - (void)updateWithLocalData:(id)localData;
 - (void)recomputeLayout;
 - (NSRange)computeRangeToLayout;
@@ -73,6 +114,7 @@
 - (void)unmountItemAtIndex:(NSInteger)index;
 - (void)requestItemsForVisibleRange;
 - (BOOL)hasRenderedItemAtIndex:(NSInteger)index;
+- (NSString *)itemTypeAtIndex:(NSInteger)index;
 - (NSRange)expandRangeWithOverscan:(NSRange)range;
 
 // Layout computation
@@ -9,13 +9,29 @@
 #import <float.h>
 #import "SmartCollectionViewLocalData.h"
 #import "SmartCollectionViewWrapperView.h"
+#import "SmartCollectionViewItemView.h"
 #import "SmartCollectionViewShadowView.h"
 #import "SmartCollectionViewLayoutCache.h"
-#import "SmartCollectionViewLayoutSpec.h"
 #import "SmartCollectionViewVisibilityTracker.h"
 #import "SmartCollectionViewMountController.h"
 #import "SmartCollectionViewEventBus.h"
 #import "SmartCollectionViewScheduler.h"
+#import "SmartCollectionViewOffsetIndex.h"
+#import "SmartCollectionViewMaxTree.h"
+#import "SmartCollectionViewAxis.h"
+#import "HorizontalGridLayoutProvider.h"
+#import "VerticalGridLayoutProvider.h"
+#import "MasonryLayoutProvider.h"
+#import "SmartCollectionViewBatchController.h"
+#import "SmartCollectionViewCreditController.h"
+#import "SmartCollectionViewMountPolicy.h"
+#import "SmartCollectionViewKeyedSizeCache.h"
+#import "SmartCollectionViewPersistentSizeCache.h"
+#import "SmartCollectionViewSizeEstimator.h"
+#import "SmartCollectionViewSectionIndex.h"
+#import "SmartCollectionViewWindowPolicy.h"
+#import "SmartCollectionViewCostModel.h"
+#import <QuartzCore/QuartzCore.h>
 
 // Debug logging helper
 #ifdef DEBUG
@@ -28,26 +44,64 @@
 
 @property (nonatomic, strong) SmartCollectionViewLocalData *localData;
 @property (nonatomic, strong) NSMutableDictionary<NSNumber *, UIView *> *childViewRegistry;
+@property (nonatomic, strong) NSMutableDictionary<NSNumber *, UIView *> *childViewsByIndex; // Rendered child per data index
 @property (nonatomic, strong) NSMutableDictionary<NSNumber *, SmartCollectionViewWrapperView *> *indexToWrapper;
 @property (nonatomic, strong) NSMutableArray<SmartCollectionViewWrapperView *> *wrapperReusePool;
-@property (nonatomic, strong) NSMutableSet<NSNumber *> *renderedIndices; // Track which indices JS has rendered
+@property (nonatomic, strong) NSMutableIndexSet *renderedIndices; // Track which indices JS has rendered
 @property (nonatomic, assign) BOOL isUpdatingVisibleItems;
 @property (nonatomic, strong, readwrite) SmartCollectionViewLayoutCache *layoutCache;
 @property (nonatomic, strong, readwrite) SmartCollectionViewVisibilityTracker *visibilityTracker;
 @property (nonatomic, strong, readwrite) SmartCollectionViewMountController *mountController;
 @property (nonatomic, strong, readwrite) SmartCollectionViewEventBus *eventBus;
 @property (nonatomic, strong, readwrite) SmartCollectionViewScheduler *scheduler;
+@property (nonatomic, strong, readwrite) SmartCollectionViewPersistentSizeCache *persistentSizeCache;
+@property (nonatomic, strong, readwrite) id<SmartCollectionViewLayoutProvider> layoutProvider;
+@property (nonatomic, assign) CGSize layoutProviderViewport; // Bounds the provider was last prepared with
+@property (nonatomic, strong, readwrite) SmartCollectionViewSectionIndex *sectionIndex;
+@property (nonatomic, assign) NSInteger pinnedHeaderIndex; // Header currently drawn at the leading edge; NSNotFound when none
 @property (nonatomic, strong) NSMutableSet<NSNumber *> *appliedIndicesThisTick;
 @property (nonatomic, assign) BOOL hasScrolled; // Track if user has scrolled (to switch from initial to scroll props)
+@property (nonatomic, assign) CGFloat maxCrossLength; // Cross-axis size used for the last frame pass
+@property (nonatomic, strong) SmartCollectionViewMaxTree *crossLengths; // Per-item cross-axis size; its max sizes a horizontal list
+@property (nonatomic, strong) NSMutableIndexSet *changedIndices; // Items whose measured size changed since the last layout pass
+@property (nonatomic, assign) BOOL mountFollowUpScheduled; // Adaptive mode left ready items for the next runloop
+@property (nonatomic, assign) BOOL unmountCheckScheduled; // An item outside the exit band is waiting out its dwell time
 
 - (NSInteger)itemCount;
 - (CGSize)sizeForItemAtIndex:(NSInteger)index;
 - (UIView *)viewForItemAtIndex:(NSInteger)index;
+- (NSInteger)itemIndexOfChildView:(UIView *)view;
+- (void)attachChildView:(UIView *)view atIndex:(NSInteger)index;
+- (void)detachChildView:(UIView *)view atIndex:(NSInteger)index;
 - (CGSize)metadataSizeForItemAtIndex:(NSInteger)index;
+- (BOOL)hasMeasuredSizeAtIndex:(NSInteger)index;
+- (BOOL)loadPersistedSize:(CGSize *)size atIndex:(NSInteger)index;
+- (CGSize)fallbackSizeForItemAtIndex:(NSInteger)index;
 - (SmartCollectionViewWrapperView *)dequeueWrapper;
 - (void)recycleWrapper:(SmartCollectionViewWrapperView *)wrapper;
 - (void)ensureWrapperPoolCapacity;
 - (NSInteger)estimatedItemsPerViewport;
+- (NSInteger)distanceOfIndex:(NSInteger)index fromRange:(NSRange)range;
+- (void)restoreFramesInRange:(NSRange)range;
+- (void)updateLayoutProvider;
+- (void)remapItemsToKeys:(NSArray<NSString *> *)keys;
+- (void)updateStickyHeaders;
+- (void)unpinStickyHeader;
+- (void)recordMountDuration:(CFTimeInterval)duration forIndex:(NSInteger)index;
+- (void)recordLayoutDuration:(CFTimeInterval)duration forItemCount:(NSInteger)count;
+- (void)applyAdaptiveBatchSize;
+- (void)performChangedItemsLayoutUpdate;
+- (void)performProviderLayoutUpdateForIndices:(nullable NSIndexSet *)indices;
+- (void)performListLayoutUpdateForChangedIndices;
+- (NSInteger)listAnchorIndexWithOffset:(CGFloat *)anchorOffset;
+- (CGFloat)listCrossLength;
+- (void)applyListCrossLength;
+- (void)finishListLayoutWithItemCount:(NSInteger)itemCount
+                    firstChangedIndex:(NSInteger)firstChangedIndex
+                       maxCrossLength:(CGFloat)maxCrossLength
+                          anchorIndex:(NSInteger)anchorIndex
+                         anchorOffset:(CGFloat)anchorOffset;
+- (NSInteger)adaptiveBatchSizeForIndices:(NSArray<NSNumber *> *)indices fallback:(NSInteger)fallback;
 
 @end
 
@@ -66,11 +120,21 @@
 {
     _virtualItems = [NSMutableArray array];
     _layoutCache = [[SmartCollectionViewLayoutCache alloc] init];
-    _cumulativeOffsets = [NSMutableArray array];
+    _offsetIndex = [[SmartCollectionViewOffsetIndex alloc] init];
+    _crossLengths = [[SmartCollectionViewMaxTree alloc] init];
+    _changedIndices = [NSMutableIndexSet indexSet];
+    _batchController = [[SmartCollectionViewBatchController alloc] init];
+    _creditController = [[SmartCollectionViewCreditController alloc] init];
+    _mountPolicy = [[SmartCollectionViewMountPolicy alloc] init];
+    _keyedSizeCache = [[SmartCollectionViewKeyedSizeCache alloc] init];
+    _sizeEstimator = [[SmartCollectionViewSizeEstimator alloc] init];
+    _sectionIndex = [[SmartCollectionViewSectionIndex alloc] init];
     _childViewRegistry = [NSMutableDictionary dictionary];
+    _childViewsByIndex = [NSMutableDictionary dictionary];
     _indexToWrapper = [NSMutableDictionary dictionary];
     _wrapperReusePool = [NSMutableArray array];
-    _renderedIndices = [NSMutableSet set];
+    _renderedIndices = [NSMutableIndexSet indexSet];
+    _mountedIndices = [NSMutableIndexSet indexSet];
     __weak typeof(self) weakSelf = self;
     _visibilityTracker = [[SmartCollectionViewVisibilityTracker alloc] initWithSizeProvider:^CGSize(NSInteger index) {
         return [weakSelf sizeForItemAtIndex:index];
@@ -84,18 +148,39 @@
     _overscanCount = 5;
     _overscanLength = 1.0;
     _shadowBufferMultiplier = 2.0; // Default: request 2x the mount range
+    _predictiveWindowing = NO;
+    _maxVisibleRequestsPerBatch = 0;
+    _maxMountBufferRequestsPerBatch = 0;
+    _maxShadowRequestsPerBatch = 0;
+    _adaptiveBatching = NO;
+    _frameBudget = 4.0;
+    _adaptiveShadowBuffer = NO;
+    _maxOutstandingRequests = 0;
+    _acknowledgedGeneration = 0;
+    _unmountDwellTime = 0;
+    _visibleLayoutCacheBudget = 0;
+    _bufferLayoutCacheBudget = 0;
+    _coldLayoutCacheBudget = 0;
+    _itemKeys = nil;
+    _persistentSizeCacheName = nil;
     _initialMaxToRenderPerBatch = 0; // 0 = use maxToRenderPerBatch
     _initialOverscanCount = 0; // 0 = use overscanCount
     _initialOverscanLength = 0; // 0 = use overscanLength
     _initialShadowBufferMultiplier = 0; // 0 = use shadowBufferMultiplier
     _hasScrolled = NO;
     _horizontal = YES;
+    _layoutType = @"list";
+    _rowCount = 2;
+    _minimumItemWidth = 0;
+    _stickyHeaderIndices = nil;
+    _pinnedHeaderIndex = NSNotFound;
     _estimatedItemSize = CGSizeMake(100, 80);
     _totalItemCount = 0;
     _needsFullRecompute = YES;
     _mountedCount = 0;
     _scrollOffset = 0;
     _contentSize = CGSizeZero;
+    _maxCrossLength = 0;
     
     // Create scroll view
     _scrollView = [[UIScrollView alloc] initWithFrame:self.bounds];
@@ -118,6 +203,7 @@
                                                     mountController:_mountController
                                                            eventBus:_eventBus];
     _scheduler.horizontal = _horizontal;
+    _scheduler.offsetIndex = _offsetIndex;
     _scheduler.initialNumToRender = _initialNumToRender;
     [self updateSchedulerWithEffectiveValues];
     _appliedIndicesThisTick = [NSMutableSet set];
@@ -129,11 +215,9 @@
 
 - (NSInteger)estimatedItemsPerViewport
 {
-    if (!_horizontal) {
-        return 1;
-    }
-    CGFloat viewport = MAX(self.bounds.size.width, 1);
-    CGFloat item = MAX(_estimatedItemSize.width, 1);
+    SCVAxis axis = SCVAxisMake(_horizontal);
+    CGFloat viewport = MAX(SCVAxisLength(self.bounds.size, axis), 1);
+    CGFloat item = MAX(SCVAxisLength(_estimatedItemSize, axis), 1);
     NSInteger per = (NSInteger)ceil(viewport / item);
     return MAX(1, per);
 }
@@ -167,6 +251,17 @@
     if (self.window && self.reactTag) {
         [self syncPropsToShadowView];
     }
+
+    // Leaving the screen: hand the sizes measured this session to disk
+    if (!self.window) {
+        [self.persistentSizeCache synchronize];
+    }
+
+    // Adaptive batching never takes more than a share of the display's frame
+    NSInteger framesPerSecond = self.window.screen.maximumFramesPerSecond;
+    if (framesPerSecond > 0) {
+        self.batchController.frameDuration = 1.0 / (NSTimeInterval)framesPerSecond;
+    }
 }
 
 - (void)didAddSubview:(UIView *)subview
@@ -177,13 +272,10 @@
     // Diagnostic: Log when any subview is added (including our internal ones)
     SCVLog(@"didAddSubview: %@ (tag: %@, isReactChild: %@, my tag: %@)", NSStringFromClass([subview class]), subview.reactTag, subview.reactTag ? @"YES" : @"NO", self.reactTag);
     
-    // If this is a React child (has reactTag), register it
+    // If this is a React child (has reactTag), register it at the index it carries
     if (subview.reactTag && subview != _scrollView && subview != _containerView) {
-        NSInteger index = [self.reactSubviews indexOfObject:subview];
-        if (index != NSNotFound) {
-            SCVLog(@"✅ didAddSubview: Registering React child at index %ld, tag: %@", (long)index, subview.reactTag);
-            [self registerChildView:subview atIndex:index];
-        }
+        SCVLog(@"✅ didAddSubview: Registering React child for index %ld, tag: %@", (long)[self itemIndexOfChildView:subview], subview.reactTag);
+        [self registerChildView:subview];
     }
 }
 
@@ -207,6 +299,12 @@
     
     // Update scroll view frame
     _scrollView.frame = self.bounds;
+
+    // Vertical rows span the list and grid columns divide it, so a width change moves every frame
+    CGFloat laidOutWidth = self.layoutProvider ? _layoutProviderViewport.width : _maxCrossLength;
+    if (!_horizontal && self.bounds.size.width > 0 && self.bounds.size.width != laidOutWidth) {
+        _needsFullRecompute = YES;
+    }
     
     // Recompute layout if we have data and need it
     // This handles both initial layout and when bounds become available after being zero
@@ -222,9 +320,9 @@
     [self requestItemsForVisibleRange];
 }
 
-- (void)addVirtualItem:(UIView *)item atIndex:(NSInteger)index
+- (void)addVirtualItem:(UIView *)item
 {
-    if (index >= 0 && index <= _virtualItems.count) {
+    if (![_virtualItems containsObject:item]) {
         NSNumber *reactTag = item.reactTag;
         if (reactTag != nil) {
             _childViewRegistry[reactTag] = item;
@@ -234,11 +332,10 @@
             [item removeFromSuperview];
         }
 
-        [_virtualItems insertObject:item atIndex:index];
-        _needsFullRecompute = YES;
+        [_virtualItems addObject:item];
         self.scheduler.totalItemCount = [self itemCount];
         
-        SCVLog(@"Added virtual item at index %ld, total items: %ld", (long)index, (long)_virtualItems.count);
+        SCVLog(@"Added virtual item for index %ld, total items: %ld", (long)[self itemIndexOfChildView:item], (long)_virtualItems.count);
         SCVLog(@"Child tag %@ initial frame %@", item.reactTag, NSStringFromCGRect(item.frame));
         
         // DON'T call recomputeLayout here - wait for updateWithLocalData to provide complete metadata
@@ -249,30 +346,42 @@
 
 - (void)removeVirtualItem:(UIView *)item
 {
-    NSInteger index = [_virtualItems indexOfObject:item];
-    if (index != NSNotFound) {
-        [_virtualItems removeObjectAtIndex:index];
-        NSNumber *reactTag = item.reactTag;
-        if (reactTag != nil) {
-            [_childViewRegistry removeObjectForKey:reactTag];
-        }
-        [_mountedIndices removeObject:@(index)];
-        _needsFullRecompute = YES;
-        self.scheduler.totalItemCount = [self itemCount];
-        
-        SCVLog(@"Removed virtual item at index %ld, total items: %ld", (long)index, (long)_virtualItems.count);
-        
-        [self recomputeLayout];
+    if (![_virtualItems containsObject:item]) {
+        return;
+    }
+    [_virtualItems removeObject:item];
+    NSNumber *reactTag = item.reactTag;
+    if (reactTag != nil) {
+        [_childViewRegistry removeObjectForKey:reactTag];
+    }
+    
+    // Keyed by the data index the child carries, not its position among children.
+    // Clearing the rendered sets lets the scheduler request the index again.
+    NSInteger index = [self itemIndexOfChildView:item];
+    if (index >= 0 && [_mountedIndices containsIndex:index] &&
+        _indexToWrapper[@(index)].subviews.firstObject == item) {
+        [self unmountItemAtIndex:index];
     }
+    [self detachChildView:item atIndex:index];
+    
+    // The data did not change, so the layout stays valid
+    SCVLog(@"Removed virtual item for index %ld, total items: %ld", (long)index, (long)_virtualItems.count);
 }
 
-- (void)registerChildView:(UIView *)view atIndex:(NSInteger)index
+- (void)registerChildView:(UIView *)view
 {
-    SCVLog(@"registerChildView: view tag %@ at index %ld", view.reactTag, (long)index);
+    NSInteger index = [self itemIndexOfChildView:view];
+    SCVLog(@"registerChildView: view tag %@ for index %ld", view.reactTag, (long)index);
+    if (index < 0) {
+        SCVLog(@"❌ registerChildView: child carries no item index, not placing it");
+        return;
+    }
+    if (_childViewsByIndex[@(index)] == view) {
+        return; // Registered through the other insertion path already
+    }
     
     // Mark this index as rendered
-    [_renderedIndices addObject:@(index)];
-    [self.scheduler updateRenderedIndices:[NSSet setWithSet:_renderedIndices]];
+    [self attachChildView:view atIndex:index];
     
     // Also add to registry immediately by reactTag
     if (view.reactTag != nil) {
@@ -280,7 +389,7 @@
         SCVLog(@"Added to childViewRegistry: tag %@", view.reactTag);
     }
     
-    [self addVirtualItem:view atIndex:index];
+    [self addVirtualItem:view];
     
     // After adding a new item, check if we should trigger layout and mounting
     // This handles the case where items arrive after scroll (requested via onRequestItems)
@@ -289,10 +398,13 @@
         // Local data exists, so layout should be possible
         // Trigger update to check if we can now mount items that were waiting
         dispatch_async(dispatch_get_main_queue(), ^{
-            // Check if this item is in the current visible/mount range
+            // Check if this item is in the current mount range, or in the landing
+            // window a fling requested ahead of the items in between
             NSRange currentRange = [self computeRangeToLayout];
-            if (index >= currentRange.location && index < NSMaxRange(currentRange)) {
-                SCVLog(@"New item %ld is in current mount range %@ - triggering update", (long)index, NSStringFromRange(currentRange));
+            NSRange landingRange = [self.scheduler landingRange];
+            if (NSLocationInRange(index, currentRange) || NSLocationInRange(index, landingRange) ||
+                index == self.scheduler.pinnedIndex) {
+                SCVLog(@"New item %ld is in mount range %@ or landing range %@ - triggering update", (long)index, NSStringFromRange(currentRange), NSStringFromRange(landingRange));
                 [self updateVisibleItems];
             }
         });
@@ -304,6 +416,44 @@
     [self removeVirtualItem:view];
 }
 
+- (void)childView:(UIView *)view didMoveFromIndex:(NSInteger)previousIndex
+{
+    if (![_virtualItems containsObject:view]) {
+        return; // Not registered yet; registration reads the new index
+    }
+    [self detachChildView:view atIndex:previousIndex];
+    NSInteger index = [self itemIndexOfChildView:view];
+    if (index >= 0) {
+        [self attachChildView:view atIndex:index];
+    }
+}
+
+- (NSInteger)itemIndexOfChildView:(UIView *)view
+{
+    if (![view isKindOfClass:[SmartCollectionViewItemView class]]) {
+        return -1;
+    }
+    return ((SmartCollectionViewItemView *)view).itemIndex;
+}
+
+- (void)attachChildView:(UIView *)view atIndex:(NSInteger)index
+{
+    _childViewsByIndex[@(index)] = view;
+    [_renderedIndices addIndex:index];
+    [self.scheduler noteItemRendered:index];
+}
+
+// Only when the index still belongs to view: during a keyed move another child may have taken it
+- (void)detachChildView:(UIView *)view atIndex:(NSInteger)index
+{
+    if (index < 0 || _childViewsByIndex[@(index)] != view) {
+        return;
+    }
+    [_childViewsByIndex removeObjectForKey:@(index)];
+    [_renderedIndices removeIndex:index];
+    [self.scheduler noteItemRemoved:index];
+}
+
 - (void)updateWithLocalData:(SmartCollectionViewLocalData *)localData
 {
     // BREAKPOINT: Set breakpoint here - this confirms localData arrived from manager
@@ -311,8 +461,54 @@
     
     // Ensure we're on main queue (manager may call from shadow thread)
     dispatch_async(dispatch_get_main_queue(), ^{
+        SmartCollectionViewLocalData *previousData = self.localData;
         self.localData = localData;
         self.scheduler.totalItemCount = [self itemCount];
+        CGFloat layoutWidth = self.bounds.size.width;
+        
+        // Only items whose size changed go through the next layout pass
+        NSMutableIndexSet *changedIndices = self->_changedIndices;
+        if (!self.itemKeys) {
+            // Sizes come straight from the metadata; a child that went away falls back to its estimate
+            for (SmartCollectionViewItemMetadata *meta in localData.items) {
+                SmartCollectionViewItemMetadata *previous = [previousData itemAtIndex:meta.index];
+                if (meta.index >= 0 && (!previous || !CGSizeEqualToSize(previous.size, meta.size))) {
+                    [changedIndices addIndex:meta.index];
+                }
+            }
+            for (SmartCollectionViewItemMetadata *meta in previousData.items) {
+                if (meta.index >= 0 && ![localData itemAtIndex:meta.index]) {
+                    [changedIndices addIndex:meta.index];
+                }
+            }
+        }
+        
+        for (SmartCollectionViewItemMetadata *meta in localData.items) {
+            if (meta.reactTag || meta.key) {
+                NSInteger index = meta.key ? [self.keyedSizeCache indexForKey:meta.key] : meta.index;
+                [self.sizeEstimator recordSize:meta.size
+                                       forItem:meta.key ?: meta.reactTag
+                                          type:[self itemTypeAtIndex:index]
+                                   layoutWidth:layoutWidth];
+            }
+            if (meta.key) {
+                // Keyed sizes outlive their children; only a new measurement changes one
+                NSInteger keyedIndex = [self.keyedSizeCache indexForKey:meta.key];
+                CGSize previousSize;
+                if (keyedIndex != NSNotFound &&
+                    (![self.keyedSizeCache getSize:&previousSize atIndex:keyedIndex] || !CGSizeEqualToSize(previousSize, meta.size))) {
+                    [changedIndices addIndex:keyedIndex];
+                }
+                [self.keyedSizeCache setSize:meta.size forKey:meta.key];
+                if (self.persistentSizeCache && layoutWidth > 0) {
+                    NSInteger index = [self.keyedSizeCache indexForKey:meta.key];
+                    [self.persistentSizeCache setSize:meta.size
+                                               forKey:meta.key
+                                             itemType:[self itemTypeAtIndex:index]
+                                          layoutWidth:layoutWidth];
+                }
+            }
+        }
         SCVLog(@"✅ Received local data version %ld, items %lu", (long)localData.version, (unsigned long)localData.items.count);
         if (localData.items.count > 0) {
             SmartCollectionViewItemMetadata *first = localData.items.firstObject;
@@ -331,9 +527,7 @@
             SCVLog(@"  Tag %@ -> view frame: %@", tag, NSStringFromCGRect(view.frame));
         }
         
-        self->_needsFullRecompute = YES;
-        
-        // Force layout recompute - handle zero bounds case
+        // Handle zero bounds case
         if (CGRectEqualToRect(self.bounds, CGRectZero)) {
             SCVLog(@"⚠️  Bounds are zero, will recompute when bounds are set");
             // Layout will be triggered when bounds are set in layoutSubviews
@@ -350,20 +544,19 @@
     if (_totalItemCount > 0) {
         return _totalItemCount;
     }
-    NSInteger metadataCount = self.localData ? self.localData.items.count : 0;
+    NSInteger metadataCount = self.localData ? self.localData.indexCount : 0;
     return MAX(_virtualItems.count, metadataCount);
 }
 
 - (CGSize)metadataSizeForItemAtIndex:(NSInteger)index
 {
     if (self.localData) {
-        SCVLog(@"metadataSizeForItemAtIndex %ld: localData.items.count=%lu", (long)index, (unsigned long)self.localData.items.count);
-        if (index < self.localData.items.count) {
-            SmartCollectionViewItemMetadata *metadata = self.localData.items[index];
+        SmartCollectionViewItemMetadata *metadata = [self.localData itemAtIndex:index];
+        if (metadata) {
             SCVLog(@"Metadata[%ld] tag %@ size %@", (long)index, metadata.reactTag, NSStringFromCGSize(metadata.size));
             return metadata.size;
         } else {
-            SCVLog(@"Index %ld out of bounds for localData (count %lu)", (long)index, (unsigned long)self.localData.items.count);
+            SCVLog(@"Index %ld not rendered (localData has %lu items)", (long)index, (unsigned long)self.localData.items.count);
         }
     } else {
         SCVLog(@"metadataSizeForItemAtIndex %ld: localData is nil", (long)index);
@@ -373,21 +566,68 @@
 
 - (CGSize)sizeForItemAtIndex:(NSInteger)index
 {
+    if (self.itemKeys) {
+        // Keyed lists: the size measured for the item now at this index, wherever it was measured
+        CGSize keyedSize;
+        if ([self.keyedSizeCache getSize:&keyedSize atIndex:index] || [self loadPersistedSize:&keyedSize atIndex:index]) {
+            return keyedSize;
+        }
+        return [self fallbackSizeForItemAtIndex:index];
+    }
     CGSize metadataSize = [self metadataSizeForItemAtIndex:index];
     if (!CGSizeEqualToSize(metadataSize, CGSizeZero)) {
         SCVLog(@"sizeForItemAtIndex %ld: using metadata size %@", (long)index, NSStringFromCGSize(metadataSize));
         return metadataSize;
     }
-    SCVLog(@"sizeForItemAtIndex %ld: using estimated size %@", (long)index, NSStringFromCGSize(_estimatedItemSize));
+    SCVLog(@"sizeForItemAtIndex %ld: using estimated size", (long)index);
+    return [self fallbackSizeForItemAtIndex:index];
+}
+
+// Unmeasured items: what items of the same type measured at this width, else estimatedItemSize
+- (CGSize)fallbackSizeForItemAtIndex:(NSInteger)index
+{
+    CGSize learnedSize;
+    if ([self.sizeEstimator getEstimatedSize:&learnedSize forType:[self itemTypeAtIndex:index] layoutWidth:self.bounds.size.width]) {
+        return learnedSize;
+    }
     return _estimatedItemSize;
 }
 
+- (BOOL)hasMeasuredSizeAtIndex:(NSInteger)index
+{
+    if (self.itemKeys) {
+        return [self.keyedSizeCache getSize:NULL atIndex:index] || [self loadPersistedSize:NULL atIndex:index];
+    }
+    return !CGSizeEqualToSize([self metadataSizeForItemAtIndex:index], CGSizeZero);
+}
+
+// Seeds the keyed cache from a previous launch; the size counts as measured
+// until Yoga reports the item again
+- (BOOL)loadPersistedSize:(CGSize *)size atIndex:(NSInteger)index
+{
+    NSString *key = [self.keyedSizeCache keyAtIndex:index];
+    CGFloat layoutWidth = self.bounds.size.width;
+    if (!self.persistentSizeCache || !key || layoutWidth <= 0) {
+        return NO;
+    }
+    CGSize persistedSize;
+    if (![self.persistentSizeCache getSize:&persistedSize forKey:key itemType:[self itemTypeAtIndex:index] layoutWidth:layoutWidth]) {
+        return NO;
+    }
+    [self.keyedSizeCache setSize:persistedSize forKey:key];
+    if (size) {
+        *size = persistedSize;
+    }
+    return YES;
+}
+
 - (UIView *)viewForItemAtIndex:(NSInteger)index
 {
     SCVLog(@"viewForItemAtIndex %ld", (long)index);
     
-    if (self.localData && index < self.localData.items.count) {
-        SmartCollectionViewItemMetadata *metadata = self.localData.items[index];
+    // Measured children only; metadata is keyed by the data index each child carries
+    SmartCollectionViewItemMetadata *metadata = [self.localData itemAtIndex:index];
+    if (metadata) {
         SCVLog(@"Looking for view with reactTag %@ in registry (count: %lu)", metadata.reactTag, (unsigned long)_childViewRegistry.count);
         
         // Log all registered tags
@@ -406,7 +646,7 @@
         if (!self.localData) {
             SCVLog(@"viewForItemAtIndex %ld: localData is nil", (long)index);
         } else {
-            SCVLog(@"viewForItemAtIndex %ld: index out of bounds (localData.items.count=%lu)", (long)index, (unsigned long)self.localData.items.count);
+            SCVLog(@"viewForItemAtIndex %ld: no metadata for index (%lu items rendered)", (long)index, (unsigned long)self.localData.items.count);
         }
     }
 
@@ -419,6 +659,8 @@
     if (_needsFullRecompute) {
         [self performFullLayoutRecompute];
         _needsFullRecompute = NO;
+    } else if (_changedIndices.count > 0) {
+        [self performChangedItemsLayoutUpdate];
     } else {
         [self performIncrementalLayoutUpdate];
     }
@@ -448,90 +690,213 @@
         SCVLog(@"⚠️  Bounds are zero, using estimated item sizes for initial layout calculation");
     }
     
-    // CURRENTLY: Horizontal list/grid layout only
-    // TODO: When adding vertical list or grid layouts, refactor into separate methods:
-    //   - performHorizontalLayoutRecompute (current implementation)
-    //   - performVerticalLayoutRecompute (future)
-    //   - performHorizontalGridLayoutRecompute (future)
-    //   - performVerticalGridLayoutRecompute (future)
-    
-    // For now, assert horizontal layout (POC scope)
-    if (!_horizontal) {
-        SCVLog(@"ERROR: Vertical layout not yet supported. Only horizontal layout is implemented.");
-        return;
+    if (self.layoutProvider) {
+        [self performProviderLayoutRecompute];
+    } else {
+        [self performListLayoutRecompute];
     }
-    
-    [self performHorizontalLayoutRecompute];
 }
 
-#pragma mark - Horizontal Layout (Current Implementation)
+#pragma mark - List Layout
 
-- (void)performHorizontalLayoutRecompute
+// One pass for both axes: SCVAxis indexes the size/point components, so the
+// loops below never branch on orientation. Horizontal lists size themselves
+// to the tallest item; vertical lists take their width from the parent.
+- (void)performListLayoutRecompute
 {
-    [self.layoutCache removeAllSpecs];
-    [_cumulativeOffsets removeAllObjects];
-    
-    // First pass: calculate actual item sizes and find max height
-    CGFloat maxHeight = 0;
-    NSMutableArray *actualSizes = [NSMutableArray array];
-    
+    CFTimeInterval layoutStart = CACurrentMediaTime();
+    SCVAxis axis = SCVAxisMake(_horizontal);
+    [_changedIndices removeAllIndexes]; // Every item is read below
+
     // Use the maximum of virtualItems count and localData items count
     NSInteger itemCount = [self itemCount];
     if (self.localData) {
-        itemCount = MAX(itemCount, self.localData.items.count);
+        itemCount = MAX(itemCount, self.localData.indexCount);
     }
 
+    // First pass: item lengths along the axis, and each item's cross-axis size
+    CGFloat *lengths = malloc(sizeof(CGFloat) * MAX(itemCount, 1));
+    CGFloat *crossLengths = malloc(sizeof(CGFloat) * MAX(itemCount, 1));
     for (NSInteger i = 0; i < itemCount; i++) {
         CGSize itemSize = [self sizeForItemAtIndex:i];
-        [actualSizes addObject:[NSValue valueWithCGSize:itemSize]];
-        
+        lengths[i] = SCVAxisLength(itemSize, axis);
+        crossLengths[i] = SCVAxisCrossLength(itemSize, axis);
+
         // Do not read from virtualItems by position; rely on metadata size for now
-        
-        if (itemSize.height > maxHeight) {
-            maxHeight = itemSize.height;
+        SCVLog(@"Measured item %ld size %@", (long)i, NSStringFromCGSize(itemSize));
+    }
+    [_crossLengths resetWithValues:crossLengths count:itemCount];
+    free(crossLengths);
+    CGFloat maxCrossLength = [self listCrossLength];
+
+    SCVLog(@"Max cross length calculated: %.2f (from %ld items)", maxCrossLength, (long)itemCount);
+
+    CGFloat anchorOffset = 0;
+    NSInteger anchorIndex = [self listAnchorIndexWithOffset:&anchorOffset];
+
+    // Second pass: update the offset index.
+    // Same item count: setLength: skips items whose length did not change, so
+    // only frames from the first changed length on are dropped. Sizes measured
+    // later do not come through here; they take the O(k log n) path in
+    // performListLayoutUpdateForChangedIndices.
+    // Different item count: rebuild the index in O(n), but keep the frames
+    // ahead of the first item whose length changed (appends, tail removals,
+    // and inserts/removes in keyed lists whose sizes follow their keys).
+    NSInteger firstChangedIndex = 0;
+    if (_offsetIndex.count == itemCount && [self.layoutCache count] > 0) {
+        firstChangedIndex = itemCount;
+        for (NSInteger i = 0; i < itemCount; i++) {
+            if ([_offsetIndex setLength:lengths[i] atIndex:i] && i < firstChangedIndex) {
+                firstChangedIndex = i;
+            }
         }
-        
-        SCVLog(@"Measured item %ld size %@ (maxHeight so far: %.2f)", (long)i, NSStringFromCGSize(itemSize), maxHeight);
+        if (maxCrossLength != _maxCrossLength) {
+            firstChangedIndex = 0; // Every frame carries the shared cross length
+        }
+    } else {
+        NSInteger previousCount = _offsetIndex.count;
+        NSInteger commonCount = MIN(previousCount, itemCount);
+        while (firstChangedIndex < commonCount && [_offsetIndex lengthAtIndex:firstChangedIndex] == lengths[firstChangedIndex]) {
+            firstChangedIndex++;
+        }
+        if (maxCrossLength != _maxCrossLength || [self.layoutCache count] == 0) {
+            firstChangedIndex = 0;
+        }
+        if (previousCount > itemCount) {
+            [self.layoutCache invalidateRange:NSMakeRange(itemCount, previousCount - itemCount)];
+        }
+        [_offsetIndex resetWithLengths:lengths count:itemCount];
     }
-    
-    SCVLog(@"Max height calculated: %.2f (from %ld items)", maxHeight, (long)itemCount);
-    
-    // Second pass: calculate frames with actual sizes (horizontal layout)
-    CGFloat currentOffset = 0;
-    
-    for (NSInteger i = 0; i < itemCount; i++) {
-        CGSize itemSize = (i < actualSizes.count) ? [actualSizes[i] CGSizeValue] : _estimatedItemSize;
-        
-        // Horizontal layout: items positioned side by side, all same height (max)
-        CGRect frame = CGRectMake(currentOffset, 0, itemSize.width, maxHeight);
-        currentOffset += itemSize.width;
-        
-        SCVLog(@"Item %ld -> size %@ frame %@ (horizontal, x: %.2f, y: %.2f, w: %.2f, h: %.2f)", 
-               (long)i, NSStringFromCGSize(itemSize), NSStringFromCGRect(frame),
-               frame.origin.x, frame.origin.y, frame.size.width, frame.size.height);
-        
-        [self.layoutCache setFrame:frame forIndex:i];
-        [_cumulativeOffsets addObject:@(currentOffset)];
+    free(lengths);
+
+    [self finishListLayoutWithItemCount:itemCount
+                      firstChangedIndex:firstChangedIndex
+                         maxCrossLength:maxCrossLength
+                            anchorIndex:anchorIndex
+                           anchorOffset:anchorOffset];
+    [self recordLayoutDuration:CACurrentMediaTime() - layoutStart forItemCount:itemCount];
+}
+
+// Late measurements: only the items in changedIndices are read, each a
+// point update on the offset index and the cross-length tree, so one card
+// measured far down a long list costs O(k log n) instead of a full pass.
+// Items still on their estimate keep it until the next full pass, even if
+// the learned estimate for their type moved.
+- (void)performListLayoutUpdateForChangedIndices
+{
+    NSInteger itemCount = [self itemCount];
+    if (self.localData) {
+        itemCount = MAX(itemCount, self.localData.indexCount);
     }
-    
+    if (_offsetIndex.count != itemCount || _crossLengths.count != itemCount || [self.layoutCache count] == 0) {
+        [self performListLayoutRecompute]; // The item count moved; the index is rebuilt
+        return;
+    }
+
+    CFTimeInterval layoutStart = CACurrentMediaTime();
+    SCVAxis axis = SCVAxisMake(_horizontal);
+    CGFloat anchorOffset = 0;
+    NSInteger anchorIndex = [self listAnchorIndexWithOffset:&anchorOffset];
+
+    NSIndexSet *changedIndices = [_changedIndices copy];
+    [_changedIndices removeAllIndexes];
+    __block NSInteger firstChangedIndex = itemCount;
+    [changedIndices enumerateIndexesUsingBlock:^(NSUInteger index, BOOL *stop) {
+        if ((NSInteger)index >= itemCount) {
+            *stop = YES;
+            return;
+        }
+        CGSize itemSize = [self sizeForItemAtIndex:index];
+        [self->_crossLengths setValue:SCVAxisCrossLength(itemSize, axis) atIndex:index];
+        if ([self->_offsetIndex setLength:SCVAxisLength(itemSize, axis) atIndex:index]) {
+            firstChangedIndex = MIN(firstChangedIndex, (NSInteger)index);
+        }
+    }];
+
+    CGFloat maxCrossLength = [self listCrossLength];
+    if (maxCrossLength != _maxCrossLength) {
+        firstChangedIndex = 0; // Every frame carries the shared cross length
+    }
+
+    SCVLog(@"Updated %lu changed items, frames from index %ld", (unsigned long)changedIndices.count, (long)firstChangedIndex);
+
+    [self finishListLayoutWithItemCount:itemCount
+                      firstChangedIndex:firstChangedIndex
+                         maxCrossLength:maxCrossLength
+                            anchorIndex:anchorIndex
+                           anchorOffset:anchorOffset];
+    [self recordLayoutDuration:CACurrentMediaTime() - layoutStart forItemCount:changedIndices.count];
+}
+
+// Anchor: the first visible item keeps its on-screen position when items
+// before it change length, so late measurements do not shift the viewport.
+// Returns -1 when there is nothing to anchor.
+- (NSInteger)listAnchorIndexWithOffset:(CGFloat *)anchorOffset
+{
+    CGFloat scrollOffset = SCVAxisOffset(_scrollView.contentOffset, SCVAxisMake(_horizontal));
+    if (_offsetIndex.count == 0 || scrollOffset <= 0 || _scrollView.isDragging) {
+        return -1;
+    }
+    NSInteger anchorIndex = MIN([_offsetIndex indexForOffset:scrollOffset], _offsetIndex.count - 1);
+    *anchorOffset = [_offsetIndex offsetAtIndex:anchorIndex];
+    return anchorIndex;
+}
+
+// Horizontal lists size themselves to the tallest item; vertical rows span the list
+- (CGFloat)listCrossLength
+{
+    if (!_horizontal && self.bounds.size.width > 0) {
+        return self.bounds.size.width;
+    }
+    return _crossLengths.maxValue;
+}
+
+- (void)finishListLayoutWithItemCount:(NSInteger)itemCount
+                    firstChangedIndex:(NSInteger)firstChangedIndex
+                       maxCrossLength:(CGFloat)maxCrossLength
+                          anchorIndex:(NSInteger)anchorIndex
+                         anchorOffset:(CGFloat)anchorOffset
+{
+    SCVAxis axis = SCVAxisMake(_horizontal);
+    _maxCrossLength = maxCrossLength;
+
+    SCVLog(@"Refreshing frames from index %ld of %ld", (long)firstChangedIndex, (long)itemCount);
+
+    // Frames from the first changed item on moved. Mark them stale in O(1);
+    // restoreFramesInRange: rebuilds them from the offset index when a mount
+    // pass reads them, so a change far from the viewport costs nothing until
+    // it scrolls in. Frames before it stay in the cache untouched.
+    if (firstChangedIndex < itemCount) {
+        [self.layoutCache invalidateRange:NSMakeRange(firstChangedIndex, itemCount - firstChangedIndex)];
+    }
+
     [self updateContentSize];
     
     // Update scroll view content size
     _scrollView.contentSize = _contentSize;
     _containerView.frame = CGRectMake(0, 0, _contentSize.width, _contentSize.height);
+
+    if (anchorIndex >= 0 && anchorIndex < itemCount) {
+        CGFloat scrollOffset = SCVAxisOffset(_scrollView.contentOffset, axis);
+        CGFloat shift = [_offsetIndex offsetAtIndex:anchorIndex] - anchorOffset;
+        if (fabs(shift) >= 0.5) {
+            CGFloat maxOffset = MAX(0, SCVAxisLength(_contentSize, axis) - SCVAxisLength(_scrollView.bounds.size, axis));
+            CGFloat offset = MIN(MAX(0, scrollOffset + shift), maxOffset);
+            _scrollView.contentOffset = SCVAxisPointWithOffset(_scrollView.contentOffset, offset, axis);
+            SCVLog(@"Anchored item %ld: shifted content offset by %.2f", (long)anchorIndex, shift);
+        }
+    }
     
-    // Update SmartCollectionView height to match max item height
+    // Horizontal lists: update SmartCollectionView height to match max item height
     // Note: If height is explicitly set via style props, React Native will override this
     // Setting frame height here is safe - it will be overridden by Yoga layout if needed
-    // Store current height to detect changes
+    // Vertical lists keep the height their parent gave them
     CGFloat previousHeight = self.frame.size.height;
-    if (maxHeight > 0) {
-        if (maxHeight != previousHeight) {
-            CGRect newFrame = self.frame;
-            newFrame.size.height = maxHeight;
-            self.frame = newFrame;
-            SCVLog(@"Updated SCV frame height: %.2f -> %.2f", previousHeight, maxHeight);
-        }
+    if (_horizontal && maxCrossLength > 0 && maxCrossLength != previousHeight) {
+        CGRect newFrame = self.frame;
+        newFrame.size.height = maxCrossLength;
+        self.frame = newFrame;
+        SCVLog(@"Updated SCV frame height: %.2f -> %.2f", previousHeight, maxCrossLength);
     }
     
     SCVLog(@"Updated scrollView.contentSize %@", NSStringFromCGSize(_contentSize));
@@ -539,14 +904,97 @@
 
     _lastComputedRange = NSMakeRange(0, itemCount);
     self.scheduler.totalItemCount = itemCount;
-    [self.scheduler updateCumulativeOffsets:[_cumulativeOffsets copy]];
     [self.scheduler notifyLayoutRecomputed];
 }
 
-// TODO: Future layout implementations
-// - (void)performVerticalLayoutRecompute { ... }
-// - (void)performHorizontalGridLayoutRecompute { ... }
-// - (void)performVerticalGridLayoutRecompute { ... }
+#pragma mark - Provider Layout
+
+// Grids: frames come from the layout provider, which keeps its own indices.
+// Frames in the cache are only invalidated here; restoreFramesInRange: asks
+// the provider for the ones a mount pass actually reads.
+- (void)performProviderLayoutRecompute
+{
+    [self performProviderLayoutUpdateForIndices:nil];
+}
+
+// indices: items whose size may have changed; nil re-reads every item
+- (void)performProviderLayoutUpdateForIndices:(nullable NSIndexSet *)indices
+{
+    CFTimeInterval layoutStart = CACurrentMediaTime();
+    id<SmartCollectionViewLayoutProvider> provider = self.layoutProvider;
+    NSInteger itemCount = [self itemCount];
+    if (self.localData) {
+        itemCount = MAX(itemCount, self.localData.indexCount);
+    }
+    [_changedIndices removeAllIndexes]; // Consumed below
+
+    // Same items and bounds: push only the sizes that may have changed, one
+    // point update each. Providers that can append take new trailing items
+    // without a rebuild.
+    NSInteger previousCount = provider.itemCount;
+    BOOL canAppend = previousCount < itemCount && [provider respondsToSelector:@selector(appendSizes:count:)];
+    BOOL changed = YES;
+    __block NSInteger measuredCount = itemCount;
+    if ((previousCount == itemCount || canAppend) && CGSizeEqualToSize(_layoutProviderViewport, self.bounds.size) && [self.layoutCache count] > 0) {
+        NSIndexSet *candidates = indices ?: [NSIndexSet indexSetWithIndexesInRange:NSMakeRange(0, previousCount)];
+        __block BOOL sizeChanged = NO;
+        measuredCount = itemCount - previousCount; // Appended items are measured too
+        [candidates enumerateIndexesUsingBlock:^(NSUInteger index, BOOL *stop) {
+            if ((NSInteger)index >= previousCount) {
+                *stop = YES; // Appended below
+                return;
+            }
+            measuredCount++;
+            if ([provider setSize:[self sizeForItemAtIndex:index] atIndex:index]) {
+                sizeChanged = YES;
+            }
+        }];
+        changed = sizeChanged;
+        if (canAppend) {
+            NSInteger appendCount = itemCount - previousCount;
+            CGSize *sizes = malloc(sizeof(CGSize) * appendCount);
+            for (NSInteger i = 0; i < appendCount; i++) {
+                sizes[i] = [self sizeForItemAtIndex:previousCount + i];
+            }
+            [provider appendSizes:sizes count:appendCount];
+            free(sizes);
+            [self.layoutCache invalidateRange:NSMakeRange(previousCount, appendCount)];
+        }
+    } else {
+        CGSize *sizes = malloc(sizeof(CGSize) * MAX(itemCount, 1));
+        for (NSInteger i = 0; i < itemCount; i++) {
+            sizes[i] = [self sizeForItemAtIndex:i];
+        }
+        [provider prepareWithSizes:sizes count:itemCount viewport:self.bounds.size];
+        free(sizes);
+        _layoutProviderViewport = self.bounds.size;
+    }
+
+    if (changed) {
+        // A column or row size moves every item after it; drop cached frames in O(1)
+        [self.layoutCache invalidateAll];
+    }
+
+    [self updateContentSize];
+    _scrollView.contentSize = _contentSize;
+    _containerView.frame = CGRectMake(0, 0, _contentSize.width, _contentSize.height);
+
+    // Horizontal grids are as tall as their rows, like lists are as tall as their tallest item
+    CGFloat previousHeight = self.frame.size.height;
+    if (_horizontal && _contentSize.height > 0 && _contentSize.height != previousHeight) {
+        CGRect newFrame = self.frame;
+        newFrame.size.height = _contentSize.height;
+        self.frame = newFrame;
+        SCVLog(@"Updated SCV frame height: %.2f -> %.2f", previousHeight, _contentSize.height);
+    }
+
+    SCVLog(@"Provider layout (%@): %ld items, content size %@", [provider layoutType], (long)itemCount, NSStringFromCGSize(_contentSize));
+
+    _lastComputedRange = NSMakeRange(0, itemCount);
+    self.scheduler.totalItemCount = itemCount;
+    [self.scheduler notifyLayoutRecomputed];
+    [self recordLayoutDuration:CACurrentMediaTime() - layoutStart forItemCount:measuredCount];
+}
 
 - (CGSize)actualSizeForItem:(UIView *)item
 {
@@ -565,6 +1013,16 @@
     return size;
 }
 
+// Only the items whose measured size changed since the last pass
+- (void)performChangedItemsLayoutUpdate
+{
+    if (self.layoutProvider) {
+        [self performProviderLayoutUpdateForIndices:[_changedIndices copy]];
+    } else {
+        [self performListLayoutUpdateForChangedIndices];
+    }
+}
+
 - (void)performIncrementalLayoutUpdate
 {
     NSRange visibleRange = [self computeRangeToLayout];
@@ -589,18 +1047,21 @@
 
 - (void)recomputeRange:(NSRange)range
 {
-    // CURRENTLY: Horizontal layout only
-    // TODO: When adding other layouts, extract horizontal-specific logic
-    
+    if (self.layoutProvider) {
+        [self restoreFramesInRange:range]; // Provider frames are never stale once restored
+        return;
+    }
+
+    SCVAxis axis = SCVAxisMake(_horizontal);
     CGFloat currentOffset = 0;
-    // Use cumulative offsets if available to avoid O(n) prefix sum
-    if (range.location > 0 && _cumulativeOffsets.count >= range.location) {
-        currentOffset = [_cumulativeOffsets[range.location - 1] doubleValue];
+    // Use the offset index if available to avoid O(n) prefix sum
+    if (range.location > 0 && _offsetIndex.count >= range.location) {
+        currentOffset = [_offsetIndex offsetAtIndex:range.location];
     } else {
         // Fallback: small prefix sum only if needed
         for (NSInteger i = 0; i < range.location; i++) {
             CGSize itemSize = [self estimatedSizeForItemAtIndex:i];
-            currentOffset += itemSize.width;
+            currentOffset += SCVAxisLength(itemSize, axis);
         }
     }
     
@@ -609,9 +1070,10 @@
         if (i < totalCount) {
             CGSize itemSize = [self estimatedSizeForItemAtIndex:i];
             
-            // Horizontal layout: items side by side
-            CGRect frame = CGRectMake(currentOffset, 0, itemSize.width, self.bounds.size.height);
-            currentOffset += itemSize.width;
+            CGFloat length = SCVAxisLength(itemSize, axis);
+            // Same cross length as restoreFramesInRange:, from the last list pass
+            CGRect frame = SCVAxisRectMake(currentOffset, length, _maxCrossLength, axis);
+            currentOffset += length;
             
             [self.layoutCache setFrame:frame forIndex:i];
         }
@@ -639,6 +1101,7 @@
     }
     
     NSRange rangeToMount = [self computeRangeToLayout];
+    [self restoreFramesInRange:rangeToMount];
     
     // For initial render, mount all items that React Native rendered (up to initialNumToRender)
     // This ensures we mount items even if they're not yet in the visible range
@@ -653,13 +1116,13 @@
         
         for (NSInteger i = rangeToMount.location; i < NSMaxRange(rangeToMount); i++) {
             if (![self.mountController isItemMountedAtIndex:i]) {
-                SmartCollectionViewLayoutSpec *spec = [self.layoutCache specForIndex:i];
+                BOOL hasFrame = [self.layoutCache hasFrameForIndex:i];
                 UIView *view = [self viewForItemAtIndex:i];
-                if (spec && view) {
+                if (hasFrame && view) {
                     [itemsToMountArray addObject:@(i)];
                 } else {
                     SCVLog(@"Skipping initial mount of index %ld - frame: %@, view: %@",
-                           (long)i, spec ? @"exists" : @"missing", view ? @"exists" : @"missing");
+                           (long)i, hasFrame ? @"exists" : @"missing", view ? @"exists" : @"missing");
                 }
             }
         }
@@ -667,7 +1130,7 @@
         SCVLog(@"Initial render: mounting %ld items from rangeToMount %@ (initialNumToRender=%ld, total available=%ld)", 
                (long)itemsToMountArray.count, NSStringFromRange(rangeToMount), (long)_initialNumToRender, (long)[self itemCount]);
         if (itemsToMountArray.count > 0) {
-            [self mountItemsBatched:itemsToMountArray batchSize:_maxToRenderPerBatch];
+            [self mountItemsBatched:itemsToMountArray batchSize:[self effectiveMaxToRenderPerBatch]];
         } else {
             SCVLog(@"⚠️  No items ready for initial mount - layout may need to run first");
         }
@@ -677,9 +1140,8 @@
         
         for (NSInteger i = rangeToMount.location; i < NSMaxRange(rangeToMount); i++) {
             if (![self.mountController isItemMountedAtIndex:i]) {
-                SmartCollectionViewLayoutSpec *spec = [self.layoutCache specForIndex:i];
                 UIView *view = [self viewForItemAtIndex:i];
-                if (spec && view) {
+                if (view && [self.layoutCache hasFrameForIndex:i]) {
                     [itemsToMount addObject:@(i)];
                 }
             } else {
@@ -687,29 +1149,86 @@
             }
         }
         
-        [self mountItemsBatched:itemsToMount batchSize:_maxToRenderPerBatch];
+        [self mountItemsBatched:itemsToMount batchSize:[self effectiveMaxToRenderPerBatch]];
     }
 }
 
 - (void)mountItemsBatched:(NSArray *)items batchSize:(NSInteger)size
+{
+    [self mountItemsBatched:items fromPosition:0 batchSize:size];
+}
+
+- (void)mountItemsBatched:(NSArray *)items fromPosition:(NSInteger)start batchSize:(NSInteger)size
 {
     dispatch_async(dispatch_get_main_queue(), ^{
-        NSInteger end = MIN(self.mountedCount + size, items.count);
+        // Adaptive mode re-sizes every chunk from the latest per-type cost estimates
+        NSInteger chunk = size;
+        if (self.adaptiveBatching) {
+            NSArray<NSNumber *> *remaining = [items subarrayWithRange:NSMakeRange(start, items.count - start)];
+            chunk = [self adaptiveBatchSizeForIndices:remaining fallback:[self effectiveMaxToRenderPerBatch]];
+        }
+        NSInteger end = MIN(start + MAX(1, chunk), (NSInteger)items.count);
         
-        for (NSInteger i = self.mountedCount; i < end; i++) {
+        for (NSInteger i = start; i < end; i++) {
             NSNumber *indexNumber = items[i];
             NSInteger index = [indexNumber integerValue];
+            CFTimeInterval mountStart = CACurrentMediaTime();
             [self mountItemAtIndex:index];
+            [self recordMountDuration:CACurrentMediaTime() - mountStart forIndex:index];
         }
+        [self applyAdaptiveBatchSize];
         
-        _mountedCount = end;
+        self->_mountedCount = end;
         
         if (end < items.count) {
-            [self mountItemsBatched:items batchSize:size];
+            [self mountItemsBatched:items fromPosition:end batchSize:size];
         }
     });
 }
 
+- (void)recordMountDuration:(CFTimeInterval)duration forIndex:(NSInteger)index
+{
+    if (!self.adaptiveBatching) {
+        return;
+    }
+    [self.batchController recordDuration:duration forItemType:[self itemTypeAtIndex:index]];
+}
+
+// Measuring and laying out an item is main-thread work its batch pays for too
+- (void)recordLayoutDuration:(CFTimeInterval)duration forItemCount:(NSInteger)count
+{
+    if (!self.adaptiveBatching) {
+        return;
+    }
+    [self.batchController recordLayoutDuration:duration forItemCount:count];
+}
+
+// Once per mount pass: requests follow the same budget as mounts
+- (void)applyAdaptiveBatchSize
+{
+    if (!self.adaptiveBatching) {
+        return;
+    }
+    self.scheduler.maxToRenderPerBatch = [self effectiveMaxToRenderPerBatch];
+}
+
+- (NSInteger)adaptiveBatchSizeForIndices:(NSArray<NSNumber *> *)indices fallback:(NSInteger)fallback
+{
+    return [self.batchController batchSizeForCount:indices.count
+                                itemTypeAtPosition:^NSString *(NSInteger position) {
+        return [self itemTypeAtIndex:[indices[position] integerValue]];
+    }
+                                          fallback:fallback];
+}
+
+- (NSString *)itemTypeAtIndex:(NSInteger)index
+{
+    if (index < 0 || index >= (NSInteger)self.itemTypes.count) {
+        return nil;
+    }
+    return self.itemTypes[index];
+}
+
 - (void)mountItemAtIndex:(NSInteger)index
 {
     if (index < 0) {
@@ -723,13 +1242,12 @@
         return;
     }
     
-    SmartCollectionViewLayoutSpec *spec = [self.layoutCache specForIndex:index];
-    if (!spec) {
+    if (![self.layoutCache hasFrameForIndex:index]) {
         SCVLog(@"❌ mountItemAtIndex: No layout spec for index %ld", (long)index);
         return;
     }
 
-    CGRect frame = spec.frame;
+    CGRect frame = [self.layoutCache frameForIndex:index];
     if (CGRectIsEmpty(frame) || CGRectIsNull(frame)) {
         SCVLog(@"❌ mountItemAtIndex: Invalid frame %@ for index %ld", NSStringFromCGRect(frame), (long)index);
         return;
@@ -778,8 +1296,8 @@
         SCVLog(@"✅ Updated React child frame for reused wrapper");
     }
 
-    if (![_mountedIndices containsObject:@(index)]) {
-        [_mountedIndices addObject:@(index)];
+    if (![_mountedIndices containsIndex:index]) {
+        [_mountedIndices addIndex:index];
         SCVLog(@"✅ Successfully mounted item %ld - wrapper: %@, in hierarchy: %@, mounted count: %lu", 
                (long)index, NSStringFromCGRect(wrapper.frame), wrapper.superview ? @"YES" : @"NO", (unsigned long)_mountedIndices.count);
     } else {
@@ -810,36 +1328,41 @@
     
     // Check if this item's actual height is larger than what we calculated
     // If so, we need to recalculate layout with the new max height
-    if (itemActualSize.height > 0) {
-        // Get the current max height from our layout cache
-        CGFloat currentCalculatedMaxHeight = 0;
-        for (SmartCollectionViewLayoutSpec *existingSpec in [self.layoutCache allSpecs]) {
-            if (existingSpec.frame.size.height > currentCalculatedMaxHeight) {
-                currentCalculatedMaxHeight = existingSpec.frame.size.height;
-            }
-        }
+    if (_horizontal && !self.layoutProvider && itemActualSize.height > 0 && index < _crossLengths.count) {
+        // The max tree already holds the tallest item; no scan over the cached frames
+        CGFloat currentCalculatedMaxHeight = _maxCrossLength;
 
         if (itemActualSize.height > currentCalculatedMaxHeight) {
             SCVLog(@"⚠️  Mounted item %ld has actual height %.2f > calculated max %.2f, triggering height recalculation",
                    (long)index, itemActualSize.height, currentCalculatedMaxHeight);
 
-            spec.frame = CGRectMake(spec.frame.origin.x,
-                                    spec.frame.origin.y,
-                                    spec.frame.size.width,
-                                    itemActualSize.height);
-            [self.layoutCache setSpec:spec forIndex:index];
-
-            _needsFullRecompute = YES;
+            [_crossLengths setValue:itemActualSize.height atIndex:index];
             dispatch_async(dispatch_get_main_queue(), ^{
-                [self recomputeLayout];
+                [self applyListCrossLength];
             });
         }
     }
 }
 
+// The tallest item of a horizontal list changed outside a layout pass;
+// lengths along the axis did not, so only the shared cross length moves
+- (void)applyListCrossLength
+{
+    CGFloat maxCrossLength = [self listCrossLength];
+    if (self.layoutProvider || maxCrossLength == _maxCrossLength) {
+        return;
+    }
+    [self finishListLayoutWithItemCount:_offsetIndex.count
+                      firstChangedIndex:0
+                         maxCrossLength:maxCrossLength
+                            anchorIndex:-1
+                           anchorOffset:0];
+    [self mountVisibleItemsWithBatching];
+}
+
 - (void)unmountItemAtIndex:(NSInteger)index
 {
-    if ([_mountedIndices containsObject:@(index)]) {
+    if ([_mountedIndices containsIndex:index]) {
         SmartCollectionViewWrapperView *wrapper = _indexToWrapper[@(index)];
         if (wrapper) {
             UIView *item = wrapper.subviews.firstObject;
@@ -852,7 +1375,7 @@
             [self recycleWrapper:wrapper];
             [_indexToWrapper removeObjectForKey:@(index)];
         }
-        [_mountedIndices removeObject:@(index)];
+        [_mountedIndices removeIndex:index];
     }
 }
 
@@ -862,7 +1385,7 @@
 
 - (BOOL)hasRenderedItemAtIndex:(NSInteger)index
 {
-    return [_renderedIndices containsObject:@(index)];
+    return index >= 0 && [_renderedIndices containsIndex:index];
 }
 
 - (NSRange)expandRangeWithOverscan:(NSRange)range
@@ -884,14 +1407,21 @@
     self.scheduler.overscanCount = effectiveOverscanCount;
     self.scheduler.overscanLength = effectiveOverscanLength;
     self.scheduler.shadowBufferMultiplier = effectiveShadowBuffer;
+    // Items beyond 2x overscan past the mount range are safe to unmount
+    self.mountPolicy.exitMargin = MAX(1, effectiveOverscanCount * 2);
 }
 
 - (NSInteger)effectiveMaxToRenderPerBatch
 {
+    NSInteger configured = _maxToRenderPerBatch;
     if (!_hasScrolled && _initialMaxToRenderPerBatch > 0) {
-        return _initialMaxToRenderPerBatch;
+        configured = _initialMaxToRenderPerBatch;
+    }
+    if (_adaptiveBatching) {
+        // Static props seed the batch until the first measurement
+        return [self.batchController batchSizeWithFallback:configured];
     }
-    return _maxToRenderPerBatch;
+    return configured;
 }
 
 - (NSInteger)effectiveOverscanCount
@@ -940,7 +1470,7 @@
         [self updateSchedulerWithEffectiveValues]; // Switch to scroll props
     }
     
-    _scrollOffset = scrollView.contentOffset.x; // Horizontal scroll offset
+    _scrollOffset = SCVAxisOffset(scrollView.contentOffset, SCVAxisMake(_horizontal)); // Offset along the scroll axis
     self.scheduler.scrollOffset = scrollView.contentOffset;
     self.scheduler.viewportSize = scrollView.bounds.size;
     self.scheduler.totalItemCount = [self itemCount];
@@ -954,6 +1484,14 @@
                                  content:scrollView.contentSize
                                  visible:scrollView.bounds.size];
 
+    // Pinned headers move with every tick, even when no window does
+    [self updateStickyHeaders];
+
+    // Most ticks move by a fraction of an item; skip request/mount work when no window moved
+    if (![self.scheduler windowsChangedSinceLastCheck]) {
+        return;
+    }
+
     [self.scheduler requestItemsIfNeeded];
     [self updateVisibleItems];
 
@@ -963,15 +1501,27 @@
 
 - (void)scrollViewWillBeginDragging:(UIScrollView *)scrollView
 {
+    // A new drag invalidates any landing projected by the previous fling
+    [self.scheduler clearProjectedTargetOffset];
     [self.eventBus emitScrollBeginDrag];
 }
 
+- (void)scrollViewWillEndDragging:(UIScrollView *)scrollView
+                     withVelocity:(CGPoint)velocity
+              targetContentOffset:(inout CGPoint *)targetContentOffset
+{
+    // UIKit already knows where the fling will rest; start rendering there now
+    [self.scheduler noteProjectedTargetOffset:*targetContentOffset velocity:velocity];
+    [self.scheduler requestItemsIfNeeded];
+}
+
 - (void)scrollViewDidEndDragging:(UIScrollView *)scrollView willDecelerate:(BOOL)decelerate
 {
     [self.eventBus emitScrollEndDrag];
 
     if (!decelerate) {
         [self.eventBus emitScrollEndDecelerating];
+        [self.scheduler notifyScrollEnded];
     }
 }
 
@@ -984,39 +1534,48 @@
 {
     [self.eventBus emitMomentumScrollEnd];
     [self.eventBus emitScrollEndDecelerating];
+    [self.scheduler notifyScrollEnded];
     [self.scheduler requestItemsIfNeeded];
 }
 
 - (void)updateContentSize
 {
-    // CURRENTLY: Horizontal layout only
-    // TODO: When adding vertical layouts, refactor into separate methods
-    
+    SCVAxis axis = SCVAxisMake(_horizontal);
     NSInteger count = [self itemCount];
     if (count == 0) {
         _contentSize = CGSizeZero;
         return;
     }
+
+    if (self.layoutProvider) {
+        _contentSize = [self.layoutProvider contentSize];
+        return;
+    }
     
-    // Horizontal layout: sum widths for content width
-    CGFloat totalWidth = 0;
-    for (NSInteger i = 0; i < count; i++) {
-        CGSize itemSize = [self sizeForItemAtIndex:i];
-        totalWidth += itemSize.width;
+    // Sum of item lengths along the axis
+    // The offset index already holds the running total; only fall back to summing when it is stale
+    CGFloat totalLength = 0;
+    if (_offsetIndex.count == count) {
+        totalLength = _offsetIndex.totalLength;
+    } else {
+        for (NSInteger i = 0; i < count; i++) {
+            CGSize itemSize = [self sizeForItemAtIndex:i];
+            totalLength += SCVAxisLength(itemSize, axis);
+        }
     }
     
-    // Content size: width = sum of item widths, height = container height
-    _contentSize = CGSizeMake(totalWidth, self.bounds.size.height);
+    // Content size: total length along the axis, container size across it
+    _contentSize = SCVAxisSizeMake(totalLength, SCVAxisCrossLength(self.bounds.size, axis), axis);
     
-    SCVLog(@"Updated content size %@ (horizontal layout)", NSStringFromCGSize(_contentSize));
+    SCVLog(@"Updated content size %@ (%@ list)", NSStringFromCGSize(_contentSize), _horizontal ? @"horizontal" : @"vertical");
 }
 
 - (CGFloat)getCumulativeOffsetAtIndex:(NSInteger)index
 {
-    if (index >= _cumulativeOffsets.count) {
+    if (index < 0 || index >= _offsetIndex.count) {
         return 0;
     }
-    return [_cumulativeOffsets[index] floatValue];
+    return [_offsetIndex endOffsetAtIndex:index];
 }
 
 - (NSRange)visibleItemRange
@@ -1037,46 +1596,56 @@
     
     NSRange visibleRange = [self visibleItemRange];
     NSRange rangeToMount = [self computeRangeToLayout];
+    NSRange landingRange = [self.scheduler landingRange];
     
     SCVLog(@"Visible range %@, rangeToMount %@", NSStringFromRange(visibleRange), NSStringFromRange(rangeToMount));
     
+    // Frames evicted from the layout cache are rebuilt from the offset index before mounting
+    [self restoreFramesInRange:rangeToMount];
+    [self restoreFramesInRange:landingRange];
+    
     // First, check which items in rangeToMount actually have views available
     NSMutableSet *itemsReadyToMount = [NSMutableSet set];
     NSMutableSet *itemsNotReady = [NSMutableSet set];
     
     for (NSInteger i = rangeToMount.location; i < NSMaxRange(rangeToMount); i++) {
         UIView *view = [self viewForItemAtIndex:i];
-        SmartCollectionViewLayoutSpec *spec = [self.layoutCache specForIndex:i];
-        if (view && spec) {
+        BOOL hasFrame = [self.layoutCache hasFrameForIndex:i];
+        if (view && hasFrame) {
             [itemsReadyToMount addObject:@(i)];
         } else {
             [itemsNotReady addObject:@(i)];
-            SCVLog(@"Item %ld not ready: view=%@, spec=%@", (long)i, view ? @"YES" : @"NO", spec ? @"YES" : @"NO");
+            SCVLog(@"Item %ld not ready: view=%@, spec=%@", (long)i, view ? @"YES" : @"NO", hasFrame ? @"YES" : @"NO");
         }
     }
-    
-    // Only unmount items if we have replacements ready, OR if they're far outside the visible range
-    // Use a larger unmount threshold to prevent premature unmounting
-    NSRange unmountRange = [self expandRangeWithOverscan:visibleRange];
-    NSInteger unmountThreshold = _overscanCount * 2; // Items beyond 2x overscan are safe to unmount
-    
-    NSMutableSet *indicesToUnmount = [NSMutableSet set];
-    for (NSNumber *mountedIndex in _mountedIndices) {
-        NSInteger index = [mountedIndex integerValue];
-        
-        // Unmount if:
-        // 1. Item is outside the unmount range (far from visible)
-        // 2. OR item is outside rangeToMount AND we have at least one replacement ready
-        BOOL isFarOutsideVisible = (index < unmountRange.location - unmountThreshold || 
-                                   index >= NSMaxRange(unmountRange) + unmountThreshold);
-        BOOL hasReplacementReady = (itemsReadyToMount.count > 0 && index < rangeToMount.location);
-        
-        if (isFarOutsideVisible || (hasReplacementReady && index < rangeToMount.location)) {
-            [indicesToUnmount addObject:mountedIndex];
-        } else if (index >= NSMaxRange(rangeToMount) && itemsReadyToMount.count > 0) {
-            // Also unmount items beyond rangeToMount if we have replacements
-            [indicesToUnmount addObject:mountedIndex];
+
+    // Items around a projected fling landing are mounted as soon as they are rendered
+    for (NSInteger i = landingRange.location; i < NSMaxRange(landingRange); i++) {
+        if (NSLocationInRange(i, rangeToMount)) {
+            continue;
         }
+        if ([self viewForItemAtIndex:i] && [self.layoutCache hasFrameForIndex:i]) {
+            [itemsReadyToMount addObject:@(i)];
+        }
+    }
+    
+    // Unmount only past the exit band (wider than rangeToMount) so edge jitter does not thrash wrappers;
+    // the landing window stays mounted until the fling settles
+    NSMutableIndexSet *readyIndices = [NSMutableIndexSet indexSet];
+    for (NSNumber *indexNumber in itemsReadyToMount) {
+        [readyIndices addIndex:indexNumber.unsignedIntegerValue];
+    }
+    CGFloat velocity = self.scheduler.windowPolicy.velocity;
+    NSInteger direction = (velocity > 0) ? 1 : ((velocity < 0) ? -1 : 0);
+    SmartCollectionViewMountDecision *decision = [self.mountPolicy decisionWithEnterRange:rangeToMount
+                                                                              pinnedRange:landingRange
+                                                                             readyIndices:readyIndices
+                                                                           mountedIndices:_mountedIndices
+                                                                                direction:direction
+                                                                                   atTime:CACurrentMediaTime()];
+    NSMutableIndexSet *indicesToUnmount = [decision.indicesToUnmount mutableCopy];
+    if (_pinnedHeaderIndex != NSNotFound) {
+        [indicesToUnmount removeIndex:(NSUInteger)_pinnedHeaderIndex]; // Stays on screen while its section scrolls past
     }
     
     // Mount items that are ready (mount before unmount to reduce churn)
@@ -1087,20 +1656,41 @@
     NSInteger updatedCount = 0;
     NSInteger newMountCount = 0;
     
-    for (NSNumber *indexNumber in itemsReadyToMount) {
+    BOOL hasDeferredMounts = NO;
+    NSArray<NSNumber *> *mountOrder = [itemsReadyToMount.allObjects sortedArrayUsingComparator:^NSComparisonResult(NSNumber *a, NSNumber *b) {
+        NSInteger da = [self distanceOfIndex:a.integerValue fromRange:visibleRange];
+        NSInteger db = [self distanceOfIndex:b.integerValue fromRange:visibleRange];
+        if (da != db) {
+            return da < db ? NSOrderedAscending : NSOrderedDescending;
+        }
+        return [a compare:b];
+    }];
+    
+    // In adaptive mode only new mounts whose predicted cost fits the frame budget happen per pass
+    NSInteger newMountLimit = NSIntegerMax;
+    if (self.adaptiveBatching) {
+        NSMutableArray<NSNumber *> *newMounts = [NSMutableArray array];
+        for (NSNumber *indexNumber in mountOrder) {
+            if ([decision.indicesToMount containsIndex:indexNumber.unsignedIntegerValue]) {
+                [newMounts addObject:indexNumber];
+            }
+        }
+        newMountLimit = [self adaptiveBatchSizeForIndices:newMounts fallback:[self effectiveMaxToRenderPerBatch]];
+    }
+    
+    for (NSNumber *indexNumber in mountOrder) {
         NSInteger i = [indexNumber integerValue];
         if ([self.appliedIndicesThisTick containsObject:indexNumber]) {
             continue; // assignment dedupe per tick
         }
-        SmartCollectionViewLayoutSpec *spec = [self.layoutCache specForIndex:i];
-        CGRect frame = spec ? [spec frame] : CGRectZero;
+        CGRect frame = [self.layoutCache hasFrameForIndex:i] ? [self.layoutCache frameForIndex:i] : CGRectZero;
 
-        if ([_mountedIndices containsObject:indexNumber]) {
+        if ([_mountedIndices containsIndex:i]) {
             // Item already mounted - verify it's still in hierarchy and update if needed
             SmartCollectionViewWrapperView *wrapper = _indexToWrapper[indexNumber];
             if (!wrapper) {
                 SCVLog(@"⚠️  Item %ld marked as mounted but no wrapper found! Re-mounting", (long)i);
-                [_mountedIndices removeObject:indexNumber];
+                [_mountedIndices removeIndex:i];
                 [self mountItemAtIndex:i];
                 newMountCount++;
             } else {
@@ -1149,22 +1739,38 @@
             }
             mountedCount++;
         } else {
-            // Item not mounted yet - mount it
+            // Item not mounted yet - mount it if the policy says so
+            if (![decision.indicesToMount containsIndex:i]) {
+                continue;
+            }
+            if (newMountCount >= newMountLimit) {
+                hasDeferredMounts = YES;
+                continue;
+            }
             SCVLog(@"Mounting new item %ld", (long)i);
+            CFTimeInterval mountStart = CACurrentMediaTime();
             [self mountItemAtIndex:i];
+            [self recordMountDuration:CACurrentMediaTime() - mountStart forIndex:i];
             newMountCount++;
         }
         [self.appliedIndicesThisTick addObject:indexNumber];
     }
+    [self applyAdaptiveBatchSize];
     
     // Now unmount after mounts to avoid immediate reuse of just-unmounted wrappers
     SCVLog(@"Unmounting %lu items: %@", (unsigned long)indicesToUnmount.count, indicesToUnmount);
-    for (NSNumber *indexNum in indicesToUnmount) {
-        [self unmountItemAtIndex:[indexNum integerValue]];
-    }
+    [indicesToUnmount enumerateIndexesUsingBlock:^(NSUInteger index, BOOL *stop) {
+        [self unmountItemAtIndex:(NSInteger)index];
+    }];
+    
+    // Drop cached frames over the tier budgets, behind the scroll first; restored on demand
+    [self.layoutCache evictWithVisibleRange:visibleRange bufferRange:[self.scheduler rangeToRequest] direction:direction];
     
     SCVLog(@"Mount summary: %ld already mounted, %ld updated, %ld newly mounted", (long)mountedCount, (long)updatedCount, (long)newMountCount);
     SCVLog(@"Final mounted indices: %@", _mountedIndices);
+
+    // Mounting put the header back at its own frame
+    [self updateStickyHeaders];
     
     // Log items that were requested but aren't ready yet
     if (itemsNotReady.count > 0) {
@@ -1172,6 +1778,181 @@
     }
     
     self.isUpdatingVisibleItems = NO;
+    
+    // Finish the deferred mounts on the next runloop turn rather than waiting for a scroll tick
+    if (hasDeferredMounts && !self.mountFollowUpScheduled) {
+        self.mountFollowUpScheduled = YES;
+        __weak typeof(self) weakSelf = self;
+        dispatch_async(dispatch_get_main_queue(), ^{
+            weakSelf.mountFollowUpScheduled = NO;
+            [weakSelf updateVisibleItems];
+        });
+    }
+    
+    // Items dwelling outside the exit band unmount once their time is up, even if scrolling stopped
+    if (decision.nextEvaluationDelay >= 0 && !self.unmountCheckScheduled) {
+        self.unmountCheckScheduled = YES;
+        __weak typeof(self) weakSelf = self;
+        dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(decision.nextEvaluationDelay * NSEC_PER_SEC)), dispatch_get_main_queue(), ^{
+            weakSelf.unmountCheckScheduled = NO;
+            [weakSelf updateVisibleItems];
+        });
+    }
+}
+
+- (void)restoreFramesInRange:(NSRange)range
+{
+    SCVAxis axis = SCVAxisMake(_horizontal);
+    id<SmartCollectionViewLayoutProvider> provider = self.layoutProvider;
+    NSInteger end = MIN((NSInteger)NSMaxRange(range), provider ? provider.itemCount : _offsetIndex.count);
+    for (NSInteger i = range.location; i < end; i++) {
+        if ([self.layoutCache hasFrameForIndex:i]) {
+            continue;
+        }
+        // Same frame the layout pass produces
+        CGRect frame = provider ? [provider frameForItemAtIndex:i]
+                                : SCVAxisRectMake([_offsetIndex offsetAtIndex:i], [_offsetIndex lengthAtIndex:i], _maxCrossLength, axis);
+        BOOL exact = [self hasMeasuredSizeAtIndex:i];
+        [self.layoutCache setFrame:frame exact:exact forIndex:i];
+    }
+}
+
+// Moves mounted wrappers to the new index of their key, so an insert or remove
+// shifts positions instead of remounting everything after it. Items whose key
+// left the data are unmounted. Rendered indices follow each child's itemIndex
+// prop (childView:didMoveFromIndex:), whichever of the two updates lands first.
+- (void)remapItemsToKeys:(NSArray<NSString *> *)keys
+{
+    SmartCollectionViewKeyedSizeCache *cache = self.keyedSizeCache;
+    BOOL hadKeys = cache.count > 0;
+    NSMutableDictionary<NSNumber *, NSString *> *mountedKeys = [NSMutableDictionary dictionary];
+    NSMutableArray<NSString *> *renderedKeys = [NSMutableArray array];
+    if (hadKeys) {
+        [_mountedIndices enumerateIndexesUsingBlock:^(NSUInteger index, BOOL *stop) {
+            NSString *key = [cache keyAtIndex:(NSInteger)index];
+            mountedKeys[@(index)] = key ?: @"";
+        }];
+        [_renderedIndices enumerateIndexesUsingBlock:^(NSUInteger index, BOOL *stop) {
+            NSString *key = [cache keyAtIndex:(NSInteger)index];
+            if (key) {
+                [renderedKeys addObject:key];
+            }
+        }];
+    }
+
+    NSInteger firstChangedIndex = [cache updateKeys:keys];
+    if (!hadKeys || firstChangedIndex == NSNotFound) {
+        return;
+    }
+    if (firstChangedIndex < self.layoutProvider.itemCount) {
+        _layoutProviderViewport = CGSizeZero; // Placed items changed identity; re-prepare rather than append
+    }
+    [self unpinStickyHeader]; // The pinned index may now be a different item
+
+    NSMutableDictionary<NSNumber *, SmartCollectionViewWrapperView *> *indexToWrapper = [NSMutableDictionary dictionary];
+    NSMutableIndexSet *mountedIndices = [NSMutableIndexSet indexSet];
+    [mountedKeys enumerateKeysAndObjectsUsingBlock:^(NSNumber *oldIndex, NSString *key, BOOL *stop) {
+        SmartCollectionViewWrapperView *wrapper = self->_indexToWrapper[oldIndex];
+        NSInteger newIndex = [cache indexForKey:key];
+        if (newIndex == NSNotFound) {
+            if (wrapper) {
+                [wrapper.subviews.firstObject removeFromSuperview];
+                [wrapper removeFromSuperview];
+                wrapper.reactTag = nil;
+                wrapper.currentIndex = nil;
+                [self recycleWrapper:wrapper];
+            }
+            return;
+        }
+        if (wrapper) {
+            wrapper.currentIndex = @(newIndex);
+            indexToWrapper[@(newIndex)] = wrapper;
+        }
+        [mountedIndices addIndex:(NSUInteger)newIndex];
+    }];
+    _indexToWrapper = indexToWrapper;
+    _mountedIndices = mountedIndices;
+    [self.mountPolicy reset]; // Dwell timers were keyed by the old indices
+
+    for (NSString *key in renderedKeys) {
+        if ([cache indexForKey:key] == NSNotFound) {
+            [self.sizeEstimator removeItem:key]; // Deleted items stop counting toward their type
+        }
+    }
+    SCVLog(@"Remapped %lu mounted items to new keys (first change at %ld)",
+           (unsigned long)mountedIndices.count, (long)firstChangedIndex);
+}
+
+#pragma mark - Sticky Headers
+
+// Draws the header of the section at the leading edge over the items scrolling
+// under it. Lists only: grids and masonry have no single leading row to pin to.
+- (void)updateStickyHeaders
+{
+    NSInteger headerIndex = NSNotFound;
+    CGFloat pinnedOffset = 0;
+    if (!self.layoutProvider && self.sectionIndex.headerIndices.count > 0) {
+        [self.sectionIndex updateWithItemOffsets:_offsetIndex];
+        NSInteger section = [self.sectionIndex sectionForOffset:_scrollOffset];
+        if (section != NSNotFound) {
+            headerIndex = [self.sectionIndex headerIndexForSection:section];
+            pinnedOffset = [self.sectionIndex pinnedOffsetForSection:section
+                                                        scrollOffset:_scrollOffset
+                                                        headerLength:[_offsetIndex lengthAtIndex:headerIndex]];
+        }
+    }
+    if (headerIndex != _pinnedHeaderIndex) {
+        [self unpinStickyHeader];
+    }
+    // Requested even when far outside the request range, so it is rendered by the time it pins
+    self.scheduler.pinnedIndex = headerIndex;
+    if (headerIndex == NSNotFound) {
+        return;
+    }
+
+    // Far into a long section the header is outside the mount range; keep it mounted while pinned
+    if (![_mountedIndices containsIndex:headerIndex]) {
+        if (![self hasRenderedItemAtIndex:headerIndex]) {
+            return; // JS has not rendered the header yet; registering it triggers another pass
+        }
+        [self restoreFramesInRange:NSMakeRange(headerIndex, 1)];
+        [self mountItemAtIndex:headerIndex];
+    }
+    SmartCollectionViewWrapperView *wrapper = _indexToWrapper[@(headerIndex)];
+    if (!wrapper) {
+        return; // Mount was deferred; retried on the next pass
+    }
+    _pinnedHeaderIndex = headerIndex;
+    CGRect frame = wrapper.frame;
+    frame.origin = SCVAxisPointWithOffset(frame.origin, pinnedOffset, SCVAxisMake(_horizontal));
+    wrapper.frame = frame;
+    [_containerView bringSubviewToFront:wrapper];
+}
+
+// Puts the pinned header back at its place in the flow
+- (void)unpinStickyHeader
+{
+    if (_pinnedHeaderIndex == NSNotFound) {
+        return;
+    }
+    NSInteger index = _pinnedHeaderIndex;
+    _pinnedHeaderIndex = NSNotFound;
+    SmartCollectionViewWrapperView *wrapper = _indexToWrapper[@(index)];
+    [self restoreFramesInRange:NSMakeRange(index, 1)];
+    if (wrapper && [self.layoutCache hasFrameForIndex:index]) {
+        wrapper.frame = [self.layoutCache frameForIndex:index];
+    }
+}
+
+- (NSInteger)distanceOfIndex:(NSInteger)index fromRange:(NSRange)range
+{
+    if (index < (NSInteger)range.location) {
+        return (NSInteger)range.location - index;
+    }
+    if (index >= (NSInteger)NSMaxRange(range)) {
+        return index - (NSInteger)NSMaxRange(range) + 1;
+    }
+    return 0;
 }
 
 - (SmartCollectionViewWrapperView *)dequeueWrapper
@@ -1202,6 +1983,8 @@
 
     _horizontal = horizontal;
     self.scheduler.horizontal = horizontal;
+    self.visibilityTracker.horizontal = horizontal;
+    [self updateLayoutProvider];
     
     // Sync to shadow view for measureFunc
     [self syncPropsToShadowView];
@@ -1212,11 +1995,24 @@
     _scrollView.showsHorizontalScrollIndicator = _horizontal;
     _scrollView.showsVerticalScrollIndicator = !_horizontal;
 
-    // Trigger a full recompute with the new orientation
+    // Every cached frame is laid out along the old axis; drop them in O(1) and recompute
+    [self.layoutCache invalidateAll];
     _needsFullRecompute = YES;
     [self recomputeLayout];
 }
 
+- (void)setTotalItemCount:(NSInteger)totalItemCount
+{
+    if (_totalItemCount == totalItemCount) {
+        return;
+    }
+    _totalItemCount = totalItemCount;
+
+    // Appends and removals resize the offset index; the full pass keeps frames ahead of the change
+    _needsFullRecompute = YES;
+    [self setNeedsLayout];
+}
+
 - (void)setEstimatedItemSize:(CGSize)estimatedItemSize
 {
     if (CGSizeEqualToSize(_estimatedItemSize, estimatedItemSize)) {
@@ -1227,6 +2023,13 @@
     
     // Sync to shadow view for measureFunc
     [self syncPropsToShadowView];
+
+    // Unmeasured items change length; the layout pass invalidates frames from the first one
+    if (self.layoutProvider) {
+        [self updateLayoutProvider]; // Grid column widths may derive from the estimate
+    }
+    _needsFullRecompute = YES;
+    [self setNeedsLayout];
 }
 
 - (void)setOverscanCount:(NSInteger)overscanCount
@@ -1256,6 +2059,233 @@
     [self updateSchedulerWithEffectiveValues];
 }
 
+- (void)setPredictiveWindowing:(BOOL)predictiveWindowing
+{
+    if (_predictiveWindowing == predictiveWindowing) {
+        return;
+    }
+    _predictiveWindowing = predictiveWindowing;
+    self.scheduler.predictiveWindowing = predictiveWindowing;
+}
+
+- (void)setMaxVisibleRequestsPerBatch:(NSInteger)maxVisibleRequestsPerBatch
+{
+    if (_maxVisibleRequestsPerBatch == maxVisibleRequestsPerBatch) {
+        return;
+    }
+    _maxVisibleRequestsPerBatch = maxVisibleRequestsPerBatch;
+    self.scheduler.maxVisibleRequestsPerBatch = maxVisibleRequestsPerBatch;
+}
+
+- (void)setMaxMountBufferRequestsPerBatch:(NSInteger)maxMountBufferRequestsPerBatch
+{
+    if (_maxMountBufferRequestsPerBatch == maxMountBufferRequestsPerBatch) {
+        return;
+    }
+    _maxMountBufferRequestsPerBatch = maxMountBufferRequestsPerBatch;
+    self.scheduler.maxMountBufferRequestsPerBatch = maxMountBufferRequestsPerBatch;
+}
+
+- (void)setMaxShadowRequestsPerBatch:(NSInteger)maxShadowRequestsPerBatch
+{
+    if (_maxShadowRequestsPerBatch == maxShadowRequestsPerBatch) {
+        return;
+    }
+    _maxShadowRequestsPerBatch = maxShadowRequestsPerBatch;
+    self.scheduler.maxShadowRequestsPerBatch = maxShadowRequestsPerBatch;
+}
+
+- (void)setAdaptiveBatching:(BOOL)adaptiveBatching
+{
+    if (_adaptiveBatching == adaptiveBatching) {
+        return;
+    }
+    _adaptiveBatching = adaptiveBatching;
+    [self.batchController reset];
+    self.scheduler.batchController = adaptiveBatching ? self.batchController : nil;
+    [self updateSchedulerWithEffectiveValues];
+}
+
+- (void)setAdaptiveShadowBuffer:(BOOL)adaptiveShadowBuffer
+{
+    if (_adaptiveShadowBuffer == adaptiveShadowBuffer) {
+        return;
+    }
+    _adaptiveShadowBuffer = adaptiveShadowBuffer;
+    self.scheduler.adaptiveShadowBuffer = adaptiveShadowBuffer;
+    [self.scheduler invalidateWindows];
+}
+
+- (void)setMaxOutstandingRequests:(NSInteger)maxOutstandingRequests
+{
+    if (_maxOutstandingRequests == maxOutstandingRequests) {
+        return;
+    }
+    BOOL wasEnabled = _maxOutstandingRequests > 0;
+    _maxOutstandingRequests = maxOutstandingRequests;
+    if (maxOutstandingRequests <= 0) {
+        self.scheduler.creditController = nil;
+        [self.creditController reset];
+    } else {
+        self.creditController.maxCredits = maxOutstandingRequests;
+        if (!wasEnabled) {
+            [self.creditController reset];
+            self.scheduler.creditController = self.creditController;
+        }
+    }
+    [self.scheduler invalidateWindows];
+}
+
+- (void)setAcknowledgedGeneration:(NSInteger)acknowledgedGeneration
+{
+    if (_acknowledgedGeneration == acknowledgedGeneration) {
+        return;
+    }
+    _acknowledgedGeneration = acknowledgedGeneration;
+    if (acknowledgedGeneration > 0) {
+        [self.scheduler acknowledgeGeneration:(NSUInteger)acknowledgedGeneration];
+    }
+}
+
+- (void)setUnmountDwellTime:(CGFloat)unmountDwellTime
+{
+    _unmountDwellTime = unmountDwellTime;
+    self.mountPolicy.dwellTime = MAX(0, unmountDwellTime) / 1000.0;
+}
+
+- (void)setVisibleLayoutCacheBudget:(NSInteger)visibleLayoutCacheBudget
+{
+    _visibleLayoutCacheBudget = visibleLayoutCacheBudget;
+    [self.layoutCache setMemoryBudget:(NSUInteger)MAX(0, visibleLayoutCacheBudget) * 1024 forTier:SmartCollectionViewLayoutTierVisible];
+}
+
+- (void)setBufferLayoutCacheBudget:(NSInteger)bufferLayoutCacheBudget
+{
+    _bufferLayoutCacheBudget = bufferLayoutCacheBudget;
+    [self.layoutCache setMemoryBudget:(NSUInteger)MAX(0, bufferLayoutCacheBudget) * 1024 forTier:SmartCollectionViewLayoutTierBuffer];
+}
+
+- (void)setColdLayoutCacheBudget:(NSInteger)coldLayoutCacheBudget
+{
+    _coldLayoutCacheBudget = coldLayoutCacheBudget;
+    [self.layoutCache setMemoryBudget:(NSUInteger)MAX(0, coldLayoutCacheBudget) * 1024 forTier:SmartCollectionViewLayoutTierCold];
+}
+
+- (void)setItemKeys:(NSArray<NSString *> *)itemKeys
+{
+    _itemKeys = [itemKeys copy];
+    [self remapItemsToKeys:_itemKeys ?: @[]];
+    _needsFullRecompute = YES;
+    [self setNeedsLayout];
+}
+
+- (void)setPersistentSizeCacheName:(NSString *)persistentSizeCacheName
+{
+    if ([persistentSizeCacheName isEqualToString:_persistentSizeCacheName]) {
+        return;
+    }
+    _persistentSizeCacheName = [persistentSizeCacheName copy];
+    [self.persistentSizeCache synchronize];
+    self.persistentSizeCache = persistentSizeCacheName.length > 0
+        ? [[SmartCollectionViewPersistentSizeCache alloc] initWithPath:[SmartCollectionViewPersistentSizeCache pathForCacheName:persistentSizeCacheName]]
+        : nil;
+    _needsFullRecompute = YES;
+}
+
+- (void)setLayoutType:(NSString *)layoutType
+{
+    layoutType = layoutType ?: @"list";
+    if ([_layoutType isEqualToString:layoutType]) {
+        return;
+    }
+    _layoutType = [layoutType copy];
+    [self updateLayoutProvider];
+    [self recomputeLayout];
+}
+
+- (void)setRowCount:(NSInteger)rowCount
+{
+    rowCount = MAX(1, rowCount);
+    if (_rowCount == rowCount) {
+        return;
+    }
+    _rowCount = rowCount;
+    [self updateLayoutProvider];
+    [self recomputeLayout];
+}
+
+- (void)setMinimumItemWidth:(CGFloat)minimumItemWidth
+{
+    if (_minimumItemWidth == minimumItemWidth) {
+        return;
+    }
+    _minimumItemWidth = minimumItemWidth;
+    [self updateLayoutProvider];
+    [self recomputeLayout];
+}
+
+// Lists keep their own offset index; grids hand frames to a provider
+- (void)updateLayoutProvider
+{
+    id<SmartCollectionViewLayoutProvider> provider = nil;
+    if ([_layoutType isEqualToString:@"grid"] && _horizontal) {
+        HorizontalGridLayoutProvider *grid = [[HorizontalGridLayoutProvider alloc] init];
+        grid.rowCount = _rowCount;
+        grid.estimatedItemSize = _estimatedItemSize;
+        provider = grid;
+    } else if ([_layoutType isEqualToString:@"grid"]) {
+        VerticalGridLayoutProvider *grid = [[VerticalGridLayoutProvider alloc] init];
+        grid.minimumItemWidth = _minimumItemWidth > 0 ? _minimumItemWidth : _estimatedItemSize.width;
+        grid.estimatedItemSize = _estimatedItemSize;
+        provider = grid;
+    } else if ([_layoutType isEqualToString:@"masonry"] && !_horizontal) {
+        MasonryLayoutProvider *masonry = [[MasonryLayoutProvider alloc] init];
+        masonry.minimumItemWidth = _minimumItemWidth > 0 ? _minimumItemWidth : _estimatedItemSize.width;
+        masonry.estimatedItemSize = _estimatedItemSize;
+        provider = masonry;
+    }
+    if (!provider && !self.layoutProvider) {
+        return;
+    }
+
+    self.layoutProvider = provider;
+    self.scheduler.layoutProvider = provider;
+    // Either side's indices describe the other layout; start both over
+    [_offsetIndex removeAll];
+    [_crossLengths removeAll];
+    _maxCrossLength = 0;
+    _layoutProviderViewport = CGSizeZero;
+    [self.layoutCache invalidateAll];
+    _needsFullRecompute = YES;
+}
+
+- (void)setStickyHeaderIndices:(NSArray<NSNumber *> *)stickyHeaderIndices
+{
+    _stickyHeaderIndices = [stickyHeaderIndices copy];
+    NSMutableIndexSet *headerIndices = [NSMutableIndexSet indexSet];
+    for (NSNumber *index in stickyHeaderIndices) {
+        if (index.integerValue >= 0) {
+            [headerIndices addIndex:index.unsignedIntegerValue];
+        }
+    }
+    self.sectionIndex.headerIndices = headerIndices;
+    [self updateStickyHeaders];
+}
+
+- (void)setItemTypes:(NSArray<NSString *> *)itemTypes
+{
+    _itemTypes = [itemTypes copy];
+}
+
+- (void)setFrameBudget:(CGFloat)frameBudget
+{
+    if (_frameBudget == frameBudget) {
+        return;
+    }
+    _frameBudget = frameBudget;
+    self.batchController.frameBudget = MAX(0, frameBudget) / 1000.0;
+}
+
 - (void)setInitialMaxToRenderPerBatch:(NSInteger)initialMaxToRenderPerBatch
 {
     if (_initialMaxToRenderPerBatch == initialMaxToRenderPerBatch) {
@@ -1317,7 +2347,7 @@
     // This method can be called to force sync if needed, but for now we'll rely on
     // the shadow view's default values and props being set directly via the manager
     // TODO: Implement proper prop sync from view to shadow view if needed
-    // For now, shadow view defaults to horizontal=YES and uses estimatedItemSize from init
+    // horizontal is exported to the shadow view directly; estimatedItemSize uses its init default
     
     if (!self.reactTag) {
         return;
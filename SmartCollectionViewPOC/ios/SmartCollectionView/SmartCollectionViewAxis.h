@@ -0,0 +1,58 @@
+#import <Foundation/Foundation.h>
+#import <CoreGraphics/CoreGraphics.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+// Scroll axis of a list. The value doubles as the component index into
+// CGPoint {x, y} and CGSize {width, height}, so the layout loops read and
+// write the scroll-axis and cross-axis components without branching.
+typedef NS_ENUM(NSInteger, SCVAxis) {
+    SCVAxisHorizontal = 0,
+    SCVAxisVertical = 1,
+};
+
+static inline SCVAxis SCVAxisMake(BOOL horizontal)
+{
+    return horizontal ? SCVAxisHorizontal : SCVAxisVertical;
+}
+
+// Width for horizontal lists, height for vertical ones
+static inline CGFloat SCVAxisLength(CGSize size, SCVAxis axis)
+{
+    return ((const CGFloat *)&size)[axis];
+}
+
+static inline CGFloat SCVAxisCrossLength(CGSize size, SCVAxis axis)
+{
+    return ((const CGFloat *)&size)[1 - axis];
+}
+
+static inline CGFloat SCVAxisOffset(CGPoint point, SCVAxis axis)
+{
+    return ((const CGFloat *)&point)[axis];
+}
+
+static inline CGPoint SCVAxisPointWithOffset(CGPoint point, CGFloat offset, SCVAxis axis)
+{
+    ((CGFloat *)&point)[axis] = offset;
+    return point;
+}
+
+static inline CGSize SCVAxisSizeMake(CGFloat length, CGFloat crossLength, SCVAxis axis)
+{
+    CGSize size;
+    ((CGFloat *)&size)[axis] = length;
+    ((CGFloat *)&size)[1 - axis] = crossLength;
+    return size;
+}
+
+// Item frame starting at offset along the axis and at 0 across it
+static inline CGRect SCVAxisRectMake(CGFloat offset, CGFloat length, CGFloat crossLength, SCVAxis axis)
+{
+    CGRect rect;
+    rect.origin = SCVAxisPointWithOffset(CGPointZero, offset, axis);
+    rect.size = SCVAxisSizeMake(length, crossLength, axis);
+    return rect;
+}
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,42 @@
+#import <Foundation/Foundation.h>
+#import <CoreGraphics/CoreGraphics.h>
+
+@class SmartCollectionViewCostModel;
+
+NS_ASSUME_NONNULL_BEGIN
+
+// Returns the item type at a position in a candidate batch (nil = untyped)
+typedef NSString * _Nullable (^SmartCollectionViewItemTypeAtPosition)(NSInteger position);
+
+// Sizes mount/request batches from measured main-thread cost.
+// Keeps a smoothed mount cost per item type, plus the measure/layout cost
+// each item adds, and returns how many items fit in the frame budget, so slow
+// devices and heavy item types get smaller batches.
+@interface SmartCollectionViewBatchController : NSObject
+
+@property (nonatomic, assign) NSTimeInterval frameBudget;    // Seconds of work allowed per frame (default: 0.004)
+@property (nonatomic, assign) NSTimeInterval frameDuration;  // Seconds per frame for the current display (default: 1/60)
+@property (nonatomic, assign) NSInteger minBatchSize;        // Default: 1
+@property (nonatomic, assign) NSInteger maxBatchSize;        // Default: 50
+@property (nonatomic, assign) CGFloat smoothingFactor;       // EWMA weight of the newest sample (default: 0.25)
+
+@property (nonatomic, strong, readonly) SmartCollectionViewCostModel *costModel;
+@property (nonatomic, assign, readonly) NSTimeInterval costPerItem; // Smoothed seconds per item over all types; 0 until measured
+@property (nonatomic, assign, readonly) NSTimeInterval layoutCostPerItem; // Smoothed seconds of measure/layout per item; 0 until measured
+@property (nonatomic, assign, readonly) BOOL hasSamples;
+@property (nonatomic, assign, readonly) NSTimeInterval effectiveBudget; // frameBudget capped to a share of frameDuration
+
+- (void)recordDuration:(NSTimeInterval)duration forItemType:(nullable NSString *)type;
+// A layout pass that measured count items; added to every item's predicted mount cost
+- (void)recordLayoutDuration:(NSTimeInterval)duration forItemCount:(NSInteger)count;
+// Items that fit in the budget at the average cost; fallback until the first measurement
+- (NSInteger)batchSizeWithFallback:(NSInteger)fallback;
+// Greedy prefix of count candidates whose predicted cost fits the budget (min/max batch sizes still apply)
+- (NSInteger)batchSizeForCount:(NSInteger)count
+            itemTypeAtPosition:(SmartCollectionViewItemTypeAtPosition)itemTypeAtPosition
+                      fallback:(NSInteger)fallback;
+- (void)reset;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,123 @@
+#import "SmartCollectionViewBatchController.h"
+#import "SmartCollectionViewCostModel.h"
+
+// Never spend more than this share of a frame, whatever frameBudget says
+static const CGFloat kMaxFrameShare = 0.5;
+
+@interface SmartCollectionViewBatchController ()
+
+@property (nonatomic, strong, readwrite) SmartCollectionViewCostModel *costModel;
+@property (nonatomic, assign, readwrite) NSTimeInterval layoutCostPerItem;
+
+@end
+
+@implementation SmartCollectionViewBatchController
+
+- (instancetype)init
+{
+    self = [super init];
+    if (self) {
+        _frameBudget = 0.004;
+        _frameDuration = 1.0 / 60.0;
+        _minBatchSize = 1;
+        _maxBatchSize = 50;
+        _smoothingFactor = 0.25;
+        _costModel = [[SmartCollectionViewCostModel alloc] init];
+        _costModel.smoothingFactor = _smoothingFactor;
+    }
+    return self;
+}
+
+- (void)setSmoothingFactor:(CGFloat)smoothingFactor
+{
+    _smoothingFactor = smoothingFactor;
+    self.costModel.smoothingFactor = smoothingFactor;
+}
+
+- (NSTimeInterval)costPerItem
+{
+    return self.costModel.defaultCost;
+}
+
+- (BOOL)hasSamples
+{
+    return self.costModel.hasSamples;
+}
+
+- (NSTimeInterval)effectiveBudget
+{
+    NSTimeInterval budget = self.frameBudget;
+    if (self.frameDuration > 0) {
+        budget = MIN(budget, self.frameDuration * kMaxFrameShare);
+    }
+    return MAX(0, budget);
+}
+
+- (void)recordDuration:(NSTimeInterval)duration forItemType:(NSString *)type
+{
+    [self.costModel recordDuration:duration itemCount:1 type:type];
+}
+
+- (void)recordLayoutDuration:(NSTimeInterval)duration forItemCount:(NSInteger)count
+{
+    if (count <= 0 || duration <= 0) {
+        return;
+    }
+    NSTimeInterval sample = duration / (NSTimeInterval)count;
+    if (self.layoutCostPerItem <= 0) {
+        self.layoutCostPerItem = sample;
+        return;
+    }
+    CGFloat alpha = MIN(MAX(self.smoothingFactor, 0), 1);
+    self.layoutCostPerItem = alpha * sample + (1.0 - alpha) * self.layoutCostPerItem;
+}
+
+- (NSInteger)clampedBatchSize:(NSInteger)size
+{
+    NSInteger lower = MAX(1, self.minBatchSize);
+    NSInteger upper = MAX(lower, self.maxBatchSize);
+    return MIN(MAX(size, lower), upper);
+}
+
+- (NSInteger)batchSizeWithFallback:(NSInteger)fallback
+{
+    if (!self.hasSamples || self.costPerItem <= 0) {
+        return fallback;
+    }
+    NSTimeInterval cost = self.costPerItem + self.layoutCostPerItem;
+    return [self clampedBatchSize:(NSInteger)floor(self.effectiveBudget / cost)];
+}
+
+- (NSInteger)batchSizeForCount:(NSInteger)count
+            itemTypeAtPosition:(SmartCollectionViewItemTypeAtPosition)itemTypeAtPosition
+                      fallback:(NSInteger)fallback
+{
+    if (count <= 0) {
+        return 0;
+    }
+    if (!self.hasSamples) {
+        return MIN(count, fallback);
+    }
+
+    NSTimeInterval budget = self.effectiveBudget;
+    NSTimeInterval spent = 0;
+    NSInteger taken = 0;
+    NSInteger upper = [self clampedBatchSize:count];
+    while (taken < count && taken < upper) {
+        NSTimeInterval cost = [self.costModel predictedCostForType:itemTypeAtPosition(taken)] + self.layoutCostPerItem;
+        if (taken >= MAX(1, self.minBatchSize) && spent + cost > budget) {
+            break;
+        }
+        spent += cost;
+        taken++;
+    }
+    return taken;
+}
+
+- (void)reset
+{
+    [self.costModel reset];
+    self.layoutCostPerItem = 0;
+}
+
+@end
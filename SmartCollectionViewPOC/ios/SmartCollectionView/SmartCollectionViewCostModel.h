@@ -0,0 +1,21 @@
+#import <Foundation/Foundation.h>
+#import <CoreGraphics/CoreGraphics.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+// Learns main-thread cost per item type (from the JS getItemType prop).
+// Each type keeps an EWMA of seconds per item; types without samples
+// predict the all-types average.
+@interface SmartCollectionViewCostModel : NSObject
+
+@property (nonatomic, assign) CGFloat smoothingFactor;              // EWMA weight of the newest sample (default: 0.25)
+@property (nonatomic, assign, readonly) NSTimeInterval defaultCost; // Smoothed seconds per item over all types; 0 until measured
+@property (nonatomic, assign, readonly) BOOL hasSamples;
+
+- (void)recordDuration:(NSTimeInterval)duration itemCount:(NSInteger)count type:(nullable NSString *)type;
+- (NSTimeInterval)predictedCostForType:(nullable NSString *)type;
+- (void)reset;
+
+@end
+
+NS_ASSUME_NONNULL_END
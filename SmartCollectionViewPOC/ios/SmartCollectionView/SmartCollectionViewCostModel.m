@@ -0,0 +1,62 @@
+#import "SmartCollectionViewCostModel.h"
+
+@interface SmartCollectionViewCostModel ()
+
+@property (nonatomic, assign, readwrite) NSTimeInterval defaultCost;
+@property (nonatomic, assign, readwrite) BOOL hasSamples;
+@property (nonatomic, strong) NSMutableDictionary<NSString *, NSNumber *> *costByType;
+
+@end
+
+@implementation SmartCollectionViewCostModel
+
+- (instancetype)init
+{
+    self = [super init];
+    if (self) {
+        _smoothingFactor = 0.25;
+        _defaultCost = 0;
+        _hasSamples = NO;
+        _costByType = [NSMutableDictionary dictionary];
+    }
+    return self;
+}
+
+- (NSTimeInterval)smoothedValue:(NSTimeInterval)previous withSample:(NSTimeInterval)sample
+{
+    CGFloat alpha = MIN(MAX(self.smoothingFactor, 0), 1);
+    return alpha * sample + (1.0 - alpha) * previous;
+}
+
+- (void)recordDuration:(NSTimeInterval)duration itemCount:(NSInteger)count type:(NSString *)type
+{
+    if (count <= 0 || duration <= 0) {
+        return;
+    }
+
+    NSTimeInterval sample = duration / (NSTimeInterval)count;
+    self.defaultCost = self.hasSamples ? [self smoothedValue:self.defaultCost withSample:sample] : sample;
+    self.hasSamples = YES;
+
+    if (type.length == 0) {
+        return;
+    }
+    NSNumber *previous = self.costByType[type];
+    NSTimeInterval cost = previous ? [self smoothedValue:previous.doubleValue withSample:sample] : sample;
+    self.costByType[type] = @(cost);
+}
+
+- (NSTimeInterval)predictedCostForType:(NSString *)type
+{
+    NSNumber *cost = type.length > 0 ? self.costByType[type] : nil;
+    return cost ? cost.doubleValue : self.defaultCost;
+}
+
+- (void)reset
+{
+    self.defaultCost = 0;
+    self.hasSamples = NO;
+    [self.costByType removeAllObjects];
+}
+
+@end
@@ -0,0 +1,33 @@
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+// Flow control between native item requests and the JS renderer.
+// Every requested item holds one credit until its child registers, or the
+// request is cancelled or expires. Every onRequestItems batch also counts
+// as unacknowledged until JS reports its generation back. Once either
+// budget is used up, no new batch is issued. A stalled JS thread therefore
+// receives fewer requests, and the prioritizer ensures they are the most
+// urgent ones.
+@interface SmartCollectionViewCreditController : NSObject
+
+@property (nonatomic, assign) NSInteger maxCredits;               // Items in flight at once (default: 30)
+@property (nonatomic, assign) NSInteger maxUnacknowledgedBatches; // Batches JS has not acknowledged yet; 0 = no limit (default: 2)
+
+@property (nonatomic, assign, readonly) NSUInteger outstandingCredits;
+@property (nonatomic, assign, readonly) NSUInteger acknowledgedGeneration;
+@property (nonatomic, assign, readonly) NSUInteger unacknowledgedBatchCount;
+
+// Items that may be requested now; 0 while too many batches are unacknowledged
+- (NSUInteger)availableCredits;
+- (void)issueCredits:(NSUInteger)count forGeneration:(NSUInteger)generation;
+- (void)returnCredits:(NSUInteger)count;
+// Acknowledges every batch up to and including generation
+- (void)acknowledgeGeneration:(NSUInteger)generation;
+// Stops waiting for batches JS will never acknowledge (expired); acknowledgedGeneration does not move
+- (void)forgetGenerations:(NSIndexSet *)generations;
+- (void)reset;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,78 @@
+#import "SmartCollectionViewCreditController.h"
+
+@interface SmartCollectionViewCreditController ()
+
+@property (nonatomic, assign, readwrite) NSUInteger outstandingCredits;
+@property (nonatomic, assign, readwrite) NSUInteger acknowledgedGeneration;
+@property (nonatomic, strong) NSMutableIndexSet *unacknowledgedGenerations;
+
+@end
+
+@implementation SmartCollectionViewCreditController
+
+- (instancetype)init
+{
+    self = [super init];
+    if (self) {
+        _maxCredits = 30;
+        _maxUnacknowledgedBatches = 2;
+        _outstandingCredits = 0;
+        _acknowledgedGeneration = 0;
+        _unacknowledgedGenerations = [NSMutableIndexSet indexSet];
+    }
+    return self;
+}
+
+- (NSUInteger)unacknowledgedBatchCount
+{
+    return self.unacknowledgedGenerations.count;
+}
+
+- (NSUInteger)availableCredits
+{
+    if (self.maxUnacknowledgedBatches > 0 &&
+        self.unacknowledgedGenerations.count >= (NSUInteger)self.maxUnacknowledgedBatches) {
+        return 0;
+    }
+    NSUInteger limit = (NSUInteger)MAX(1, self.maxCredits);
+    return (self.outstandingCredits < limit) ? limit - self.outstandingCredits : 0;
+}
+
+- (void)issueCredits:(NSUInteger)count forGeneration:(NSUInteger)generation
+{
+    if (count == 0) {
+        return;
+    }
+    self.outstandingCredits += count;
+    if (generation > self.acknowledgedGeneration) {
+        [self.unacknowledgedGenerations addIndex:generation];
+    }
+}
+
+- (void)returnCredits:(NSUInteger)count
+{
+    self.outstandingCredits -= MIN(count, self.outstandingCredits);
+}
+
+- (void)acknowledgeGeneration:(NSUInteger)generation
+{
+    if (generation <= self.acknowledgedGeneration) {
+        return;
+    }
+    self.acknowledgedGeneration = generation;
+    [self.unacknowledgedGenerations removeIndexesInRange:NSMakeRange(0, generation + 1)];
+}
+
+- (void)forgetGenerations:(NSIndexSet *)generations
+{
+    [self.unacknowledgedGenerations removeIndexes:generations];
+}
+
+- (void)reset
+{
+    self.outstandingCredits = 0;
+    self.acknowledgedGeneration = 0;
+    [self.unacknowledgedGenerations removeAllIndexes];
+}
+
+@end
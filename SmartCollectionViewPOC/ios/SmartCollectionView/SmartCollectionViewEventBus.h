@@ -19,7 +19,8 @@ NS_ASSUME_NONNULL_BEGIN
                      content:(CGSize)contentSize
                      visible:(CGSize)visibleSize;
 - (void)emitVisibleRange:(NSRange)range;
-- (void)emitRequestItems:(NSArray<NSNumber *> *)indices;
+- (void)emitRequestItems:(NSArray<NSNumber *> *)indices generation:(NSUInteger)generation;
+- (void)emitCancelRequests:(NSIndexSet *)indices generation:(NSUInteger)generation;
 - (void)emitScrollBeginDrag;
 - (void)emitScrollEndDrag;
 - (void)emitMomentumScrollBegin;
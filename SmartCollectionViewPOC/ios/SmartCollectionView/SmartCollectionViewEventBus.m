@@ -95,13 +95,26 @@ static const NSTimeInterval kDefaultRangeThrottleMs = 120.0;    // coarse update
     }
 }
 
-- (void)emitRequestItems:(NSArray<NSNumber *> *)indices
+- (void)emitRequestItems:(NSArray<NSNumber *> *)indices generation:(NSUInteger)generation
 {
     if (!self.owner.onRequestItems || indices.count == 0) {
         return;
     }
 
-    self.owner.onRequestItems(@{ @"indices": indices });
+    self.owner.onRequestItems(@{ @"indices": indices, @"generation": @(generation) });
+}
+
+- (void)emitCancelRequests:(NSIndexSet *)indices generation:(NSUInteger)generation
+{
+    if (!self.owner.onCancelRequests || indices.count == 0) {
+        return;
+    }
+
+    NSMutableArray<NSNumber *> *payload = [NSMutableArray arrayWithCapacity:indices.count];
+    [indices enumerateIndexesUsingBlock:^(NSUInteger index, BOOL *stop) {
+        [payload addObject:@(index)];
+    }];
+    self.owner.onCancelRequests(@{ @"indices": payload, @"generation": @(generation) });
 }
 
 - (void)emitScrollBeginDrag
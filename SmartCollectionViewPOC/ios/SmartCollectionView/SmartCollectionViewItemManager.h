@@ -0,0 +1,5 @@
+#import <React/RCTViewManager.h>
+
+@interface SmartCollectionViewItemManager : RCTViewManager
+
+@end
@@ -0,0 +1,22 @@
+#import "SmartCollectionViewItemManager.h"
+#import "SmartCollectionViewItemView.h"
+#import "SmartCollectionViewItemShadowView.h"
+
+@implementation SmartCollectionViewItemManager
+
+RCT_EXPORT_MODULE(SmartCollectionViewItem)
+
+- (UIView *)view
+{
+    return [[SmartCollectionViewItemView alloc] init];
+}
+
+- (RCTShadowView *)shadowView
+{
+    return [[SmartCollectionViewItemShadowView alloc] init];
+}
+
+RCT_EXPORT_VIEW_PROPERTY(itemIndex, NSInteger)
+RCT_EXPORT_SHADOW_PROPERTY(itemIndex, NSInteger)
+
+@end
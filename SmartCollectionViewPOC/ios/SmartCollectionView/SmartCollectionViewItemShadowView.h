@@ -0,0 +1,12 @@
+#import <React/RCTShadowView.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+// Shadow side of SmartCollectionViewItemView; item metadata is stamped with its index
+@interface SmartCollectionViewItemShadowView : RCTShadowView
+
+@property (nonatomic, assign) NSInteger itemIndex; // -1 until set
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,23 @@
+#import "SmartCollectionViewItemShadowView.h"
+
+@implementation SmartCollectionViewItemShadowView
+
+- (instancetype)init
+{
+    self = [super init];
+    if (self) {
+        _itemIndex = -1;
+    }
+    return self;
+}
+
+- (void)setItemIndex:(NSInteger)itemIndex
+{
+    if (_itemIndex == itemIndex) {
+        return;
+    }
+    _itemIndex = itemIndex;
+    [self.superview dirtyLayout]; // Republish local data under the new index
+}
+
+@end
@@ -0,0 +1,14 @@
+#import <React/RCTView.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+// Wrapper JS renders around each item. Carries the data index the item was
+// rendered for, so children are placed by index and never by their position
+// among the rendered children (which skips whatever is not rendered).
+@interface SmartCollectionViewItemView : RCTView
+
+@property (nonatomic, assign) NSInteger itemIndex; // -1 until set
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,31 @@
+#import "SmartCollectionViewItemView.h"
+#import "SmartCollectionView.h"
+#import <React/UIView+React.h>
+
+@implementation SmartCollectionViewItemView
+
+- (instancetype)initWithFrame:(CGRect)frame
+{
+    self = [super initWithFrame:frame];
+    if (self) {
+        _itemIndex = -1;
+    }
+    return self;
+}
+
+- (void)setItemIndex:(NSInteger)itemIndex
+{
+    if (_itemIndex == itemIndex) {
+        return;
+    }
+    NSInteger previousIndex = _itemIndex;
+    _itemIndex = itemIndex;
+
+    // Keyed lists move rendered items to new indices without remounting them
+    UIView *parent = self.reactSuperview;
+    if ([parent isKindOfClass:[SmartCollectionView class]]) {
+        [(SmartCollectionView *)parent childView:self didMoveFromIndex:previousIndex];
+    }
+}
+
+@end
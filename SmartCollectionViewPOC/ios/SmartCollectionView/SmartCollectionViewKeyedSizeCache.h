@@ -0,0 +1,29 @@
+#import <Foundation/Foundation.h>
+#import <CoreGraphics/CoreGraphics.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+// Measured item sizes addressed by stable item key (from keyExtractor) rather
+// than by position, plus the key <-> index map for the current data order.
+// After an insert, remove or move, measured sizes still belong to their
+// items; only the positions (and therefore the offsets) change.
+@interface SmartCollectionViewKeyedSizeCache : NSObject
+
+@property (nonatomic, assign, readonly) NSInteger count;          // Keys in the current order
+@property (nonatomic, assign, readonly) NSUInteger measuredCount; // Keys with a measured size
+
+// Replaces the key order; sizes of keys no longer present are dropped.
+// Returns the first index whose key differs from the previous order (NSNotFound if none).
+- (NSInteger)updateKeys:(NSArray<NSString *> *)keys;
+
+- (NSInteger)indexForKey:(NSString *)key; // NSNotFound if unknown
+- (nullable NSString *)keyAtIndex:(NSInteger)index;
+
+- (void)setSize:(CGSize)size forKey:(NSString *)key;
+// Returns NO when the item at index has no measured size
+- (BOOL)getSize:(CGSize * _Nullable)size atIndex:(NSInteger)index;
+- (void)removeAll;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,109 @@
+#import "SmartCollectionViewKeyedSizeCache.h"
+
+@interface SmartCollectionViewKeyedSizeCache ()
+
+@property (nonatomic, copy) NSArray<NSString *> *keys;
+@property (nonatomic, strong) NSMutableDictionary<NSString *, NSNumber *> *indexByKey;
+@property (nonatomic, strong) NSMutableDictionary<NSString *, NSValue *> *sizeByKey;
+
+@end
+
+@implementation SmartCollectionViewKeyedSizeCache
+
+- (instancetype)init
+{
+    self = [super init];
+    if (self) {
+        _keys = @[];
+        _indexByKey = [NSMutableDictionary dictionary];
+        _sizeByKey = [NSMutableDictionary dictionary];
+    }
+    return self;
+}
+
+- (NSInteger)count
+{
+    return (NSInteger)self.keys.count;
+}
+
+- (NSUInteger)measuredCount
+{
+    return self.sizeByKey.count;
+}
+
+- (NSInteger)updateKeys:(NSArray<NSString *> *)keys
+{
+    NSArray<NSString *> *previous = self.keys;
+    NSInteger firstChanged = NSNotFound;
+    NSUInteger common = MIN(previous.count, keys.count);
+    for (NSUInteger i = 0; i < common; i++) {
+        if (![previous[i] isEqualToString:keys[i]]) {
+            firstChanged = (NSInteger)i;
+            break;
+        }
+    }
+    if (firstChanged == NSNotFound && previous.count != keys.count) {
+        firstChanged = (NSInteger)common;
+    }
+    if (firstChanged == NSNotFound) {
+        return NSNotFound;
+    }
+
+    self.keys = keys;
+    NSMutableDictionary<NSString *, NSNumber *> *indexByKey = [NSMutableDictionary dictionaryWithCapacity:keys.count];
+    [keys enumerateObjectsUsingBlock:^(NSString *key, NSUInteger index, BOOL *stop) {
+        indexByKey[key] = @(index);
+    }];
+    self.indexByKey = indexByKey;
+
+    // Sizes follow their keys; keys that left the data take their sizes with them
+    NSMutableArray<NSString *> *stale = [NSMutableArray array];
+    for (NSString *key in self.sizeByKey) {
+        if (!indexByKey[key]) {
+            [stale addObject:key];
+        }
+    }
+    [self.sizeByKey removeObjectsForKeys:stale];
+    return firstChanged;
+}
+
+- (NSInteger)indexForKey:(NSString *)key
+{
+    NSNumber *index = self.indexByKey[key];
+    return index ? index.integerValue : NSNotFound;
+}
+
+- (NSString *)keyAtIndex:(NSInteger)index
+{
+    return (index >= 0 && index < (NSInteger)self.keys.count) ? self.keys[index] : nil;
+}
+
+- (void)setSize:(CGSize)size forKey:(NSString *)key
+{
+    if (size.width <= 0 && size.height <= 0) {
+        return;
+    }
+    self.sizeByKey[key] = [NSValue valueWithBytes:&size objCType:@encode(CGSize)];
+}
+
+- (BOOL)getSize:(CGSize * _Nullable)size atIndex:(NSInteger)index
+{
+    NSString *key = [self keyAtIndex:index];
+    NSValue *value = key ? self.sizeByKey[key] : nil;
+    if (!value) {
+        return NO;
+    }
+    if (size) {
+        [value getValue:size];
+    }
+    return YES;
+}
+
+- (void)removeAll
+{
+    self.keys = @[];
+    [self.indexByKey removeAllObjects];
+    [self.sizeByKey removeAllObjects];
+}
+
+@end
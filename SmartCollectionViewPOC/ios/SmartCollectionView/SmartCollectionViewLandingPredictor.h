@@ -0,0 +1,32 @@
+#import <Foundation/Foundation.h>
+#import <CoreGraphics/CoreGraphics.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+// Tracks where a fling will come to rest (UIKit's targetContentOffset) and
+// decides whether the scheduler should jump straight to the landing window
+// instead of requesting every range the fling passes through.
+// Pure offset math along the scroll axis; the UIKit delegate only feeds inputs.
+@interface SmartCollectionViewLandingPredictor : NSObject
+
+// Landings farther than this many viewport lengths away skip intermediate ranges (default: 2.0)
+@property (nonatomic, assign) CGFloat skipThreshold;
+// Flings slower than this (points/sec) are treated as normal scrolling (default: 300)
+@property (nonatomic, assign) CGFloat minimumVelocity;
+
+@property (nonatomic, assign, readonly) BOOL hasTarget;
+@property (nonatomic, assign, readonly) CGFloat targetOffset;
+// YES while the remaining distance to the target exceeds skipThreshold
+@property (nonatomic, assign, readonly) BOOL shouldSkipIntermediateRanges;
+
+- (void)beginDecelerationFromOffset:(CGFloat)offset
+                     toTargetOffset:(CGFloat)targetOffset
+                           velocity:(CGFloat)velocity
+                     viewportLength:(CGFloat)viewportLength
+                      contentLength:(CGFloat)contentLength;
+- (void)updateWithCurrentOffset:(CGFloat)offset;
+- (void)reset;
+
+@end
+
+NS_ASSUME_NONNULL_END
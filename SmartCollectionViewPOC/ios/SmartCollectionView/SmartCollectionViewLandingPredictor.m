@@ -0,0 +1,63 @@
+#import "SmartCollectionViewLandingPredictor.h"
+
+@interface SmartCollectionViewLandingPredictor ()
+
+@property (nonatomic, assign, readwrite) BOOL hasTarget;
+@property (nonatomic, assign, readwrite) CGFloat targetOffset;
+@property (nonatomic, assign, readwrite) BOOL shouldSkipIntermediateRanges;
+@property (nonatomic, assign) CGFloat viewportLength;
+
+@end
+
+@implementation SmartCollectionViewLandingPredictor
+
+- (instancetype)init
+{
+    self = [super init];
+    if (self) {
+        _skipThreshold = 2.0;
+        _minimumVelocity = 300.0;
+        _hasTarget = NO;
+        _targetOffset = 0;
+        _shouldSkipIntermediateRanges = NO;
+        _viewportLength = 0;
+    }
+    return self;
+}
+
+- (void)beginDecelerationFromOffset:(CGFloat)offset
+                     toTargetOffset:(CGFloat)targetOffset
+                           velocity:(CGFloat)velocity
+                     viewportLength:(CGFloat)viewportLength
+                      contentLength:(CGFloat)contentLength
+{
+    if (viewportLength <= 0 || fabs(velocity) < self.minimumVelocity) {
+        [self reset];
+        return;
+    }
+
+    // UIKit may project past the content edges while bouncing; clamp to the resting range
+    CGFloat maxOffset = MAX(0, contentLength - viewportLength);
+    self.targetOffset = MIN(MAX(targetOffset, 0), maxOffset);
+    self.viewportLength = viewportLength;
+    self.hasTarget = YES;
+    [self updateWithCurrentOffset:offset];
+}
+
+- (void)updateWithCurrentOffset:(CGFloat)offset
+{
+    if (!self.hasTarget) {
+        return;
+    }
+    CGFloat remaining = fabs(self.targetOffset - offset);
+    self.shouldSkipIntermediateRanges = (remaining > self.skipThreshold * self.viewportLength);
+}
+
+- (void)reset
+{
+    self.hasTarget = NO;
+    self.targetOffset = 0;
+    self.shouldSkipIntermediateRanges = NO;
+}
+
+@end
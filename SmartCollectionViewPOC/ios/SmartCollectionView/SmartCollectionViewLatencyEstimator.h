@@ -0,0 +1,29 @@
+#import <Foundation/Foundation.h>
+#import <CoreGraphics/CoreGraphics.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+// Estimates JS render latency (onRequestItems -> registerChildView:) and turns
+// it into how many items ahead of the mount range must already be requested
+// for them to arrive in time at the current scroll velocity.
+// Smoothed mean plus mean deviation, the same shape as TCP's RTT estimator.
+@interface SmartCollectionViewLatencyEstimator : NSObject
+
+@property (nonatomic, assign) CGFloat smoothingFactor;   // Weight of the newest sample in the mean (default: 0.125)
+@property (nonatomic, assign) CGFloat deviationFactor;   // Weight of the newest sample in the deviation (default: 0.25)
+@property (nonatomic, assign) CGFloat safetyMultiplier;  // Deviations added on top of the mean (default: 2.0)
+
+@property (nonatomic, assign, readonly) NSTimeInterval smoothedLatency;
+@property (nonatomic, assign, readonly) NSTimeInterval latencyDeviation;
+@property (nonatomic, assign, readonly) BOOL hasSamples;
+
+- (void)recordLatency:(NSTimeInterval)latency;
+// Mean plus safetyMultiplier deviations
+- (NSTimeInterval)conservativeLatency;
+// Items covered at |velocity| (points/sec) during conservativeLatency
+- (NSInteger)leadItemsForVelocity:(CGFloat)velocity averageItemLength:(CGFloat)averageItemLength;
+- (void)reset;
+
+@end
+
+NS_ASSUME_NONNULL_END
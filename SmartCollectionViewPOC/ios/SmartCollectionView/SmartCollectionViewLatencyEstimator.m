@@ -0,0 +1,67 @@
+#import "SmartCollectionViewLatencyEstimator.h"
+
+@interface SmartCollectionViewLatencyEstimator ()
+
+@property (nonatomic, assign, readwrite) NSTimeInterval smoothedLatency;
+@property (nonatomic, assign, readwrite) NSTimeInterval latencyDeviation;
+@property (nonatomic, assign, readwrite) BOOL hasSamples;
+
+@end
+
+@implementation SmartCollectionViewLatencyEstimator
+
+- (instancetype)init
+{
+    self = [super init];
+    if (self) {
+        _smoothingFactor = 0.125;
+        _deviationFactor = 0.25;
+        _safetyMultiplier = 2.0;
+        _smoothedLatency = 0;
+        _latencyDeviation = 0;
+        _hasSamples = NO;
+    }
+    return self;
+}
+
+- (void)recordLatency:(NSTimeInterval)latency
+{
+    if (latency < 0) {
+        return;
+    }
+    if (!self.hasSamples) {
+        self.smoothedLatency = latency;
+        self.latencyDeviation = latency / 2.0;
+        self.hasSamples = YES;
+        return;
+    }
+
+    CGFloat alpha = MIN(MAX(self.smoothingFactor, 0), 1);
+    CGFloat beta = MIN(MAX(self.deviationFactor, 0), 1);
+    // Deviation is updated against the previous mean, before the mean moves
+    self.latencyDeviation = (1.0 - beta) * self.latencyDeviation + beta * fabs(latency - self.smoothedLatency);
+    self.smoothedLatency = (1.0 - alpha) * self.smoothedLatency + alpha * latency;
+}
+
+- (NSTimeInterval)conservativeLatency
+{
+    return self.smoothedLatency + MAX(self.safetyMultiplier, 0) * self.latencyDeviation;
+}
+
+- (NSInteger)leadItemsForVelocity:(CGFloat)velocity averageItemLength:(CGFloat)averageItemLength
+{
+    if (!self.hasSamples || averageItemLength <= 0) {
+        return 0;
+    }
+    CGFloat distance = fabs(velocity) * [self conservativeLatency];
+    return (NSInteger)ceil(distance / averageItemLength);
+}
+
+- (void)reset
+{
+    self.smoothedLatency = 0;
+    self.latencyDeviation = 0;
+    self.hasSamples = NO;
+}
+
+@end
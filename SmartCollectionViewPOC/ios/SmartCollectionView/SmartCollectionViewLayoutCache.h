@@ -5,17 +5,69 @@
 
 NS_ASSUME_NONNULL_BEGIN
 
+// What is known about an item's layout
+typedef NS_ENUM(NSInteger, SmartCollectionViewLayoutState) {
+    SmartCollectionViewLayoutStateMetadata = 0, // No frame cached; only type and length (offset index) remain
+    SmartCollectionViewLayoutStateEstimated,    // Frame from an estimated size (spec.valid == NO)
+    SmartCollectionViewLayoutStateExact,        // Frame from a measured size (spec.valid == YES)
+};
+
+// Cache tiers, by distance from the viewport
+typedef NS_ENUM(NSInteger, SmartCollectionViewLayoutTier) {
+    SmartCollectionViewLayoutTierVisible = 0,
+    SmartCollectionViewLayoutTierBuffer,
+    SmartCollectionViewLayoutTierCold,
+};
+
+// Per-index item frames.
+// Stored as parallel arrays (x, y, width, height, version, flags) in pages of
+// 256 items: O(1) access without boxing or one object per item, cheap range
+// scans, and a page is freed once its last frame is evicted. Specs are
+// materialized only on request.
+// Invalidation is O(1): invalidateAll and invalidateRange: bump a generation
+// counter, and frames stored before it read as absent (and are dropped) the
+// next time they are touched, so callers rebuild only what they read.
+// Each tier can be given a memory budget; evictWithVisibleRange: drops
+// frames beyond it, behind the scroll first and farthest from the viewport
+// first, leaving those items metadata-only.
 @interface SmartCollectionViewLayoutCache : NSObject
 
+@property (nonatomic, assign, readonly) NSUInteger evictionCount; // Frames evicted so far
+@property (nonatomic, assign, readonly) NSUInteger memoryFootprint; // Bytes held by allocated pages
+
+// Bytes one cached frame counts against a tier budget
++ (NSUInteger)bytesPerEntry;
+
 - (void)setSpec:(SmartCollectionViewLayoutSpec *)spec forIndex:(NSInteger)index;
-- (void)setFrame:(CGRect)frame forIndex:(NSInteger)index;
+- (void)setFrame:(CGRect)frame forIndex:(NSInteger)index; // Exact
+- (void)setFrame:(CGRect)frame exact:(BOOL)exact forIndex:(NSInteger)index;
+// Snapshot of the stored values; modify and pass back through setSpec:forIndex:
 - (nullable SmartCollectionViewLayoutSpec *)specForIndex:(NSInteger)index;
 - (void)removeSpecForIndex:(NSInteger)index;
 - (void)removeAllSpecs;
 - (NSArray<SmartCollectionViewLayoutSpec *> *)allSpecs;
-- (NSUInteger)count;
+- (NSUInteger)count; // Stored frames, including stale ones not touched since an invalidation
+
+// Allocation-free accessors for hot paths
+- (BOOL)hasFrameForIndex:(NSInteger)index;
+- (CGRect)frameForIndex:(NSInteger)index; // CGRectNull when no frame is stored
+- (NSInteger)versionForIndex:(NSInteger)index; // Bumped whenever the stored frame changes; -1 when none
+- (void)enumerateFramesInRange:(NSRange)range usingBlock:(void (NS_NOESCAPE ^)(NSInteger index, CGRect frame, BOOL *stop))block;
+
+// Exact -> Estimated (the measured size is stale); bumps the version
+- (void)invalidateIndex:(NSInteger)index;
+// Every stored frame / frames in range become stale, in O(1)
+- (void)invalidateAll;
+- (void)invalidateRange:(NSRange)range;
+- (SmartCollectionViewLayoutState)stateForIndex:(NSInteger)index;
+
+// 0 = unlimited (default for every tier)
+- (void)setMemoryBudget:(NSUInteger)bytes forTier:(SmartCollectionViewLayoutTier)tier;
+- (NSUInteger)memoryBudgetForTier:(SmartCollectionViewLayoutTier)tier;
+// Visible tier: visibleRange; buffer tier: bufferRange minus visibleRange; cold tier: everything else.
+// direction: > 0 toward higher indices, < 0 toward lower, 0 idle. Returns the number of frames evicted.
+- (NSUInteger)evictWithVisibleRange:(NSRange)visibleRange bufferRange:(NSRange)bufferRange direction:(NSInteger)direction;
 
 @end
 
 NS_ASSUME_NONNULL_END
-
@@ -1,72 +1,536 @@
 #import "SmartCollectionViewLayoutCache.h"
 #import "SmartCollectionViewLayoutSpec.h"
-#import <QuartzCore/QuartzCore.h>
+#import <stdlib.h>
+#import <string.h>
+
+static const NSInteger kPageShift = 8;
+static const NSInteger kPageSize = 1 << kPageShift;
+static const NSInteger kPageMask = kPageSize - 1;
+static const NSInteger kTierCount = 3;
+static const NSInteger kMaxRangeStamps = 8; // Range invalidations tracked before collapsing into a global one
+
+typedef NS_OPTIONS(uint8_t, SCVLayoutFlags) {
+    SCVLayoutFlagPresent = 1 << 0,
+    SCVLayoutFlagValid = 1 << 1, // Exact; estimated when clear
+};
+
+typedef struct {
+    CGFloat x[kPageSize];
+    CGFloat y[kPageSize];
+    CGFloat width[kPageSize];
+    CGFloat height[kPageSize];
+    NSInteger versions[kPageSize];
+    uint32_t generations[kPageSize]; // Cache generation when the frame was stored
+    uint8_t flags[kPageSize];
+    NSInteger liveCount;
+} SCVLayoutPage;
+
+// Frames in [start, end) stored before `generation` are stale
+typedef struct {
+    NSInteger start;
+    NSInteger end;
+    uint32_t generation;
+} SCVRangeStamp;
 
 @interface SmartCollectionViewLayoutCache ()
 
-@property (nonatomic, strong) NSMutableDictionary<NSNumber *, SmartCollectionViewLayoutSpec *> *specs;
+@property (nonatomic, assign, readwrite) NSUInteger evictionCount;
 
 @end
 
 @implementation SmartCollectionViewLayoutCache
+{
+    SCVLayoutPage **_pages;
+    NSInteger _pageCapacity;
+    NSInteger _pageCount;  // Allocated pages
+    NSInteger _extent;     // One past the highest index ever stored since the last reset
+    NSUInteger _count;     // Indices with a stored frame
+    NSUInteger _budgets[kTierCount];
+    uint32_t _generation;      // Stamped on every stored frame
+    uint32_t _floorGeneration; // Frames stored before this are stale everywhere
+    SCVRangeStamp _stamps[kMaxRangeStamps];
+    NSInteger _stampCount;
+}
+
++ (NSUInteger)bytesPerEntry
+{
+    return sizeof(CGFloat) * 4 + sizeof(NSInteger) + sizeof(uint32_t) + sizeof(uint8_t);
+}
 
 - (instancetype)init
 {
     self = [super init];
     if (self) {
-        _specs = [NSMutableDictionary dictionary];
+        _pages = NULL;
+        _pageCapacity = 0;
+        _pageCount = 0;
+        _extent = 0;
+        _count = 0;
+        memset(_budgets, 0, sizeof(_budgets));
+        _evictionCount = 0;
+        _generation = 0;
+        _floorGeneration = 0;
+        _stampCount = 0;
     }
     return self;
 }
 
+- (void)dealloc
+{
+    for (NSInteger p = 0; p < _pageCapacity; p++) {
+        free(_pages[p]);
+    }
+    free(_pages);
+}
+
+#pragma mark - Storage
+
+- (SCVLayoutPage *)pageForIndex:(NSInteger)index
+{
+    NSInteger p = index >> kPageShift;
+    return (index >= 0 && p < _pageCapacity) ? _pages[p] : NULL;
+}
+
+- (SCVLayoutPage *)ensurePageForIndex:(NSInteger)index
+{
+    NSInteger p = index >> kPageShift;
+    if (p >= _pageCapacity) {
+        NSInteger newCapacity = MAX(p + 1, MAX(16, _pageCapacity * 2));
+        _pages = realloc(_pages, sizeof(SCVLayoutPage *) * newCapacity);
+        memset(_pages + _pageCapacity, 0, sizeof(SCVLayoutPage *) * (newCapacity - _pageCapacity));
+        _pageCapacity = newCapacity;
+    }
+    if (!_pages[p]) {
+        // Zeroed flags read as empty; the other arrays are only read behind the present flag
+        _pages[p] = calloc(1, sizeof(SCVLayoutPage));
+        _pageCount++;
+    }
+    return _pages[p];
+}
+
+- (void)releasePageForIndex:(NSInteger)index
+{
+    NSInteger p = index >> kPageShift;
+    free(_pages[p]);
+    _pages[p] = NULL;
+    _pageCount--;
+}
+
+- (NSUInteger)memoryFootprint
+{
+    return (NSUInteger)_pageCount * sizeof(SCVLayoutPage) + (NSUInteger)_pageCapacity * sizeof(SCVLayoutPage *);
+}
+
+- (BOOL)isStoredAtIndex:(NSInteger)index
+{
+    SCVLayoutPage *page = [self pageForIndex:index];
+    return page && (page->flags[index & kPageMask] & SCVLayoutFlagPresent);
+}
+
+- (BOOL)isStaleGeneration:(uint32_t)generation atIndex:(NSInteger)index
+{
+    if (generation < _floorGeneration) {
+        return YES;
+    }
+    for (NSInteger s = 0; s < _stampCount; s++) {
+        if (generation < _stamps[s].generation && index >= _stamps[s].start && index < _stamps[s].end) {
+            return YES;
+        }
+    }
+    return NO;
+}
+
+// Stored and not invalidated since; a stale frame is dropped when it is first read
+- (BOOL)isPresentAtIndex:(NSInteger)index
+{
+    if (![self isStoredAtIndex:index]) {
+        return NO;
+    }
+    if ([self isStaleGeneration:_pages[index >> kPageShift]->generations[index & kPageMask] atIndex:index]) {
+        [self removeSpecForIndex:index];
+        return NO;
+    }
+    return YES;
+}
+
+- (void)storeFrame:(CGRect)frame version:(NSInteger)version exact:(BOOL)exact atIndex:(NSInteger)index
+{
+    SCVLayoutPage *page = [self ensurePageForIndex:index];
+    NSInteger slot = index & kPageMask;
+    if (index >= _extent) {
+        _extent = index + 1;
+    }
+    if (!(page->flags[slot] & SCVLayoutFlagPresent)) {
+        page->liveCount++;
+        _count++;
+    }
+    page->x[slot] = frame.origin.x;
+    page->y[slot] = frame.origin.y;
+    page->width[slot] = frame.size.width;
+    page->height[slot] = frame.size.height;
+    page->versions[slot] = version;
+    page->generations[slot] = _generation;
+    page->flags[slot] = SCVLayoutFlagPresent | (exact ? SCVLayoutFlagValid : 0);
+}
+
+#pragma mark - Mutation
+
 - (void)setSpec:(SmartCollectionViewLayoutSpec *)spec forIndex:(NSInteger)index
 {
-    if (!spec) {
+    if (!spec || index < 0) {
         return;
     }
     spec.index = index;
-    spec.timestamp = CACurrentMediaTime();
-    self.specs[@(index)] = spec;
+    [self storeFrame:spec.frame version:spec.version exact:spec.isValid atIndex:index];
 }
 
 - (void)setFrame:(CGRect)frame forIndex:(NSInteger)index
 {
-    SmartCollectionViewLayoutSpec *spec = [self specForIndex:index];
-    if (spec) {
-        spec.frame = frame;
-        spec.timestamp = CACurrentMediaTime();
-        spec.valid = YES;
-        self.specs[@(index)] = spec;
-    } else {
-        SmartCollectionViewLayoutSpec *newSpec = [[SmartCollectionViewLayoutSpec alloc] initWithIndex:index frame:frame];
-        [self setSpec:newSpec forIndex:index];
+    [self setFrame:frame exact:YES forIndex:index];
+}
+
+- (void)setFrame:(CGRect)frame exact:(BOOL)exact forIndex:(NSInteger)index
+{
+    if (index < 0) {
+        return;
+    }
+    if (![self isStoredAtIndex:index]) {
+        [self storeFrame:frame version:0 exact:exact atIndex:index];
+        return;
     }
+    SCVLayoutPage *page = _pages[index >> kPageShift];
+    NSInteger slot = index & kPageMask;
+    BOOL wasExact = (page->flags[slot] & SCVLayoutFlagValid) != 0;
+    BOOL changed = ([self isStaleGeneration:page->generations[slot] atIndex:index] ||
+                    page->x[slot] != frame.origin.x || page->y[slot] != frame.origin.y ||
+                    page->width[slot] != frame.size.width || page->height[slot] != frame.size.height ||
+                    wasExact != exact);
+    [self storeFrame:frame version:page->versions[slot] + (changed ? 1 : 0) exact:exact atIndex:index];
 }
 
-- (SmartCollectionViewLayoutSpec *)specForIndex:(NSInteger)index
+- (void)invalidateIndex:(NSInteger)index
 {
-    return self.specs[@(index)];
+    if (![self isPresentAtIndex:index]) {
+        return;
+    }
+    SCVLayoutPage *page = _pages[index >> kPageShift];
+    NSInteger slot = index & kPageMask;
+    if (page->flags[slot] & SCVLayoutFlagValid) {
+        page->flags[slot] &= ~SCVLayoutFlagValid;
+        page->versions[slot]++;
+    }
 }
 
 - (void)removeSpecForIndex:(NSInteger)index
 {
-    [self.specs removeObjectForKey:@(index)];
+    if (![self isStoredAtIndex:index]) {
+        return;
+    }
+    SCVLayoutPage *page = _pages[index >> kPageShift];
+    page->flags[index & kPageMask] = 0;
+    _count--;
+    if (--page->liveCount == 0) {
+        [self releasePageForIndex:index];
+    }
 }
 
 - (void)removeAllSpecs
 {
-    [self.specs removeAllObjects];
+    for (NSInteger p = 0; p < _pageCapacity; p++) {
+        free(_pages[p]);
+        _pages[p] = NULL;
+    }
+    _pageCount = 0;
+    _extent = 0;
+    _count = 0;
+    _stampCount = 0;
+}
+
+- (void)advanceGeneration
+{
+    if (_generation == UINT32_MAX) {
+        // Stamps would wrap; start over from an empty cache
+        [self removeAllSpecs];
+        _generation = 0;
+        _floorGeneration = 0;
+    }
+    _generation++;
+}
+
+- (void)invalidateAll
+{
+    [self advanceGeneration];
+    _floorGeneration = _generation;
+    _stampCount = 0;
+}
+
+- (void)invalidateRange:(NSRange)range
+{
+    NSInteger start = (NSInteger)range.location;
+    NSInteger end = MIN((NSInteger)NSMaxRange(range), _extent);
+    if (start >= end) {
+        return;
+    }
+    if (start == 0 && end == _extent) {
+        [self invalidateAll];
+        return;
+    }
+
+    [self advanceGeneration];
+    // Older stamps inside the new range add nothing
+    NSInteger kept = 0;
+    for (NSInteger s = 0; s < _stampCount; s++) {
+        if (_stamps[s].start < start || _stamps[s].end > end) {
+            _stamps[kept++] = _stamps[s];
+        }
+    }
+    _stampCount = kept;
+    if (_stampCount == kMaxRangeStamps) {
+        // Out of stamps: over-invalidate rather than scan
+        _floorGeneration = _generation;
+        _stampCount = 0;
+        return;
+    }
+    _stamps[_stampCount++] = (SCVRangeStamp){start, end, _generation};
+}
+
+#pragma mark - Access
+
+- (SmartCollectionViewLayoutSpec *)specForIndex:(NSInteger)index
+{
+    if (![self isPresentAtIndex:index]) {
+        return nil;
+    }
+    SCVLayoutPage *page = _pages[index >> kPageShift];
+    NSInteger slot = index & kPageMask;
+    SmartCollectionViewLayoutSpec *spec = [[SmartCollectionViewLayoutSpec alloc] initWithIndex:index frame:[self frameForIndex:index]];
+    spec.version = page->versions[slot];
+    spec.valid = (page->flags[slot] & SCVLayoutFlagValid) != 0;
+    return spec;
 }
 
 - (NSArray<SmartCollectionViewLayoutSpec *> *)allSpecs
 {
-    return self.specs.allValues;
+    NSMutableArray<SmartCollectionViewLayoutSpec *> *specs = [NSMutableArray arrayWithCapacity:_count];
+    [self enumerateFramesInRange:NSMakeRange(0, _extent) usingBlock:^(NSInteger index, CGRect frame, BOOL *stop) {
+        [specs addObject:[self specForIndex:index]];
+    }];
+    return specs;
 }
 
 - (NSUInteger)count
 {
-    return self.specs.count;
+    return _count;
 }
 
-@end
+- (BOOL)hasFrameForIndex:(NSInteger)index
+{
+    return [self isPresentAtIndex:index];
+}
+
+- (CGRect)frameForIndex:(NSInteger)index
+{
+    if (![self isPresentAtIndex:index]) {
+        return CGRectNull;
+    }
+    SCVLayoutPage *page = _pages[index >> kPageShift];
+    NSInteger slot = index & kPageMask;
+    return CGRectMake(page->x[slot], page->y[slot], page->width[slot], page->height[slot]);
+}
+
+- (NSInteger)versionForIndex:(NSInteger)index
+{
+    if (![self isPresentAtIndex:index]) {
+        return -1;
+    }
+    return _pages[index >> kPageShift]->versions[index & kPageMask];
+}
+
+- (SmartCollectionViewLayoutState)stateForIndex:(NSInteger)index
+{
+    if (![self isPresentAtIndex:index]) {
+        return SmartCollectionViewLayoutStateMetadata;
+    }
+    uint8_t flags = _pages[index >> kPageShift]->flags[index & kPageMask];
+    return (flags & SCVLayoutFlagValid) ? SmartCollectionViewLayoutStateExact : SmartCollectionViewLayoutStateEstimated;
+}
+
+- (void)enumerateFramesInRange:(NSRange)range usingBlock:(void (NS_NOESCAPE ^)(NSInteger index, CGRect frame, BOOL *stop))block
+{
+    NSInteger end = MIN((NSInteger)NSMaxRange(range), _extent);
+    BOOL stop = NO;
+    NSInteger i = (NSInteger)range.location;
+    while (i < end && !stop) {
+        SCVLayoutPage *page = [self pageForIndex:i];
+        if (!page) {
+            i = ((i >> kPageShift) + 1) << kPageShift;
+            continue;
+        }
+        NSInteger slot = i & kPageMask;
+        if ((page->flags[slot] & SCVLayoutFlagPresent) && ![self isStaleGeneration:page->generations[slot] atIndex:i]) {
+            block(i, CGRectMake(page->x[slot], page->y[slot], page->width[slot], page->height[slot]), &stop);
+        }
+        i++;
+    }
+}
+
+#pragma mark - Tiers
+
+- (void)setMemoryBudget:(NSUInteger)bytes forTier:(SmartCollectionViewLayoutTier)tier
+{
+    if (tier >= 0 && tier < kTierCount) {
+        _budgets[tier] = bytes;
+    }
+}
+
+- (NSUInteger)memoryBudgetForTier:(SmartCollectionViewLayoutTier)tier
+{
+    return (tier >= 0 && tier < kTierCount) ? _budgets[tier] : 0;
+}
+
+// Frames stored in [start, end)
+- (NSUInteger)countFrom:(NSInteger)start to:(NSInteger)end
+{
+    start = MAX(0, start);
+    end = MIN(end, _extent);
+    NSUInteger count = 0;
+    NSInteger i = start;
+    while (i < end) {
+        NSInteger pageStart = (i >> kPageShift) << kPageShift;
+        NSInteger pageEnd = pageStart + kPageSize;
+        SCVLayoutPage *page = [self pageForIndex:i];
+        if (page && i == pageStart && pageEnd <= end) {
+            count += page->liveCount;
+        } else if (page) {
+            for (NSInteger j = i; j < MIN(pageEnd, end); j++) {
+                if (page->flags[j & kPageMask] & SCVLayoutFlagPresent) {
+                    count++;
+                }
+            }
+        }
+        i = pageEnd;
+    }
+    return count;
+}
+
+// Next stored index in [from, limit), or -1
+- (NSInteger)nextIndexAscendingFrom:(NSInteger)from limit:(NSInteger)limit
+{
+    NSInteger i = MAX(0, from);
+    limit = MIN(limit, _extent);
+    while (i < limit) {
+        SCVLayoutPage *page = [self pageForIndex:i];
+        if (!page) {
+            i = ((i >> kPageShift) + 1) << kPageShift;
+            continue;
+        }
+        if (page->flags[i & kPageMask] & SCVLayoutFlagPresent) {
+            return i;
+        }
+        i++;
+    }
+    return -1;
+}
+
+// Previous stored index in [limit, from], or -1
+- (NSInteger)nextIndexDescendingFrom:(NSInteger)from limit:(NSInteger)limit
+{
+    NSInteger i = MIN(from, _extent - 1);
+    limit = MAX(0, limit);
+    while (i >= limit) {
+        SCVLayoutPage *page = [self pageForIndex:i];
+        if (!page) {
+            i = ((i >> kPageShift) << kPageShift) - 1;
+            continue;
+        }
+        if (page->flags[i & kPageMask] & SCVLayoutFlagPresent) {
+            return i;
+        }
+        i--;
+    }
+    return -1;
+}
 
+// Evicts frames in [outerStart, outerEnd) outside [innerStart, innerEnd), outermost first,
+// the side behind the scroll before the side ahead of it, until `count` frames are gone
+- (NSUInteger)evictCount:(NSUInteger)count
+              outerStart:(NSInteger)outerStart
+                outerEnd:(NSInteger)outerEnd
+              innerStart:(NSInteger)innerStart
+                innerEnd:(NSInteger)innerEnd
+               direction:(NSInteger)direction
+{
+    NSInteger before = [self nextIndexAscendingFrom:outerStart limit:innerStart];
+    NSInteger after = [self nextIndexDescendingFrom:outerEnd - 1 limit:innerEnd];
+    NSUInteger evicted = 0;
+    while (evicted < count && (before >= 0 || after >= 0)) {
+        BOOL takeBefore;
+        if (before < 0 || after < 0) {
+            takeBefore = (before >= 0);
+        } else if (direction != 0) {
+            takeBefore = (direction > 0);
+        } else {
+            takeBefore = (innerStart - before) >= (after - innerEnd + 1);
+        }
+
+        if (takeBefore) {
+            [self removeSpecForIndex:before];
+            before = [self nextIndexAscendingFrom:before + 1 limit:innerStart];
+        } else {
+            [self removeSpecForIndex:after];
+            after = [self nextIndexDescendingFrom:after - 1 limit:innerEnd];
+        }
+        evicted++;
+    }
+    return evicted;
+}
+
+- (NSUInteger)evictWithVisibleRange:(NSRange)visibleRange bufferRange:(NSRange)bufferRange direction:(NSInteger)direction
+{
+    if (_count == 0) {
+        return 0;
+    }
+    NSUInteger entryBytes = [[self class] bytesPerEntry];
+    NSRange hull = (bufferRange.length > 0) ? NSUnionRange(visibleRange, bufferRange) : visibleRange;
+    NSInteger visibleStart = (NSInteger)visibleRange.location;
+    NSInteger visibleEnd = (NSInteger)NSMaxRange(visibleRange);
+    NSInteger hullStart = (NSInteger)hull.location;
+    NSInteger hullEnd = (NSInteger)NSMaxRange(hull);
+    NSUInteger evicted = 0;
+
+    // Cold: everything outside the buffer hull
+    NSUInteger budget = _budgets[SmartCollectionViewLayoutTierCold];
+    if (budget > 0) {
+        NSUInteger held = _count - [self countFrom:hullStart to:hullEnd];
+        NSUInteger allowed = budget / entryBytes;
+        if (held > allowed) {
+            evicted += [self evictCount:held - allowed outerStart:0 outerEnd:_extent innerStart:hullStart innerEnd:hullEnd direction:direction];
+        }
+    }
+
+    // Buffer: the hull around the visible range
+    budget = _budgets[SmartCollectionViewLayoutTierBuffer];
+    if (budget > 0) {
+        NSUInteger held = [self countFrom:hullStart to:hullEnd] - [self countFrom:visibleStart to:visibleEnd];
+        NSUInteger allowed = budget / entryBytes;
+        if (held > allowed) {
+            evicted += [self evictCount:held - allowed outerStart:hullStart outerEnd:hullEnd innerStart:visibleStart innerEnd:visibleEnd direction:direction];
+        }
+    }
+
+    // Visible: trimmed toward the middle of the viewport
+    budget = _budgets[SmartCollectionViewLayoutTierVisible];
+    if (budget > 0) {
+        NSUInteger held = [self countFrom:visibleStart to:visibleEnd];
+        NSUInteger allowed = budget / entryBytes;
+        if (held > allowed) {
+            NSInteger middle = visibleStart + (NSInteger)visibleRange.length / 2;
+            evicted += [self evictCount:held - allowed outerStart:visibleStart outerEnd:visibleEnd innerStart:middle innerEnd:middle direction:direction];
+        }
+    }
+
+    self.evictionCount += evicted;
+    return evicted;
+}
+
+@end
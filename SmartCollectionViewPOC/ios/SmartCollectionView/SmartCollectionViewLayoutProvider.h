@@ -1,25 +1,39 @@
 #import <Foundation/Foundation.h>
-#import <UIKit/UIKit.h>
+#import <CoreGraphics/CoreGraphics.h>
 
 NS_ASSUME_NONNULL_BEGIN
 
+// Pure layout calculation over item sizes - no views, no invalidation logic.
+// The owner pushes sizes in (all at once, or one item at a time as
+// measurements arrive) and queries frames; providers keep whatever index
+// they need so queries never walk the whole list.
 @protocol SmartCollectionViewLayoutProvider <NSObject>
 
-// Pure layout calculation - no invalidation logic
-- (CGSize)contentSizeForItems:(NSArray<UIView *> *)items 
-                    viewport:(CGSize)viewport
-              scrollDirection:(BOOL)horizontal;
+// Layout type identification
+- (NSString *)layoutType;
 
-- (NSArray<NSValue *> *)layoutAttributesForElementsInRect:(CGRect)rect
-                                                   items:(NSArray<UIView *> *)items
-                                                viewport:(CGSize)viewport;
+@property (nonatomic, assign, readonly) NSInteger itemCount;
 
-- (CGRect)layoutAttributesForItemAtIndex:(NSInteger)index
-                                    items:(NSArray<UIView *> *)items
-                                 viewport:(CGSize)viewport;
+// Replaces every item size and the viewport in O(n).
+// Zero sizes are treated as unmeasured and laid out at the provider's estimate.
+- (void)prepareWithSizes:(const CGSize *)sizes count:(NSInteger)count viewport:(CGSize)viewport;
+// Resizes one item. Returns NO if no frame changed.
+- (BOOL)setSize:(CGSize)size atIndex:(NSInteger)index;
 
-// Layout type identification
-- (NSString *)layoutType;
+- (CGSize)contentSize;
+
+// Frame of one item; CGRectNull when index is out of range
+- (CGRect)frameForItemAtIndex:(NSInteger)index;
+
+// Calls block for every item whose frame intersects rect.
+// Lists and grids go in index order; masonry goes column by column.
+- (void)enumerateItemsInRect:(CGRect)rect
+                  usingBlock:(void (NS_NOESCAPE ^)(NSInteger index, CGRect frame, BOOL *stop))block;
+
+@optional
+
+// Adds items after the last one without moving any existing frame
+- (void)appendSizes:(const CGSize *)sizes count:(NSInteger)count;
 
 @end
 
@@ -7,8 +7,9 @@ NS_ASSUME_NONNULL_BEGIN
 
 @property (nonatomic, strong) NSNumber *reactTag;
 @property (nonatomic, assign) CGSize size;
-@property (nonatomic, assign) NSInteger index;
+@property (nonatomic, assign) NSInteger index; // Data index the child was rendered for
 @property (nonatomic, assign) NSInteger version;
+@property (nonatomic, copy, nullable) NSString *key; // From keyExtractor; nil when the list is not keyed
 
 - (instancetype)initWithReactTag:(NSNumber *)reactTag
                               size:(CGSize)size
@@ -19,12 +20,16 @@ NS_ASSUME_NONNULL_BEGIN
 
 @interface SmartCollectionViewLocalData : NSObject <NSCopying>
 
-@property (nonatomic, strong) NSArray<SmartCollectionViewItemMetadata *> *items;
+@property (nonatomic, strong) NSArray<SmartCollectionViewItemMetadata *> *items; // In child order, which skips unrendered indices
 @property (nonatomic, assign) NSInteger version;
+@property (nonatomic, assign, readonly) NSInteger indexCount; // One past the highest item index
 
 - (instancetype)initWithItems:(NSArray<SmartCollectionViewItemMetadata *> *)items
                        version:(NSInteger)version;
 
+// Metadata for the item rendered at a data index, or nil when it is not rendered
+- (nullable SmartCollectionViewItemMetadata *)itemAtIndex:(NSInteger)index;
+
 @end
 
 NS_ASSUME_NONNULL_END
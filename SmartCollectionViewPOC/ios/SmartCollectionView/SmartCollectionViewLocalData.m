@@ -24,12 +24,17 @@
     copy.size = self.size;
     copy.index = self.index;
     copy.version = self.version;
+    copy.key = self.key;
     return copy;
 }
 
 @end
 
 @implementation SmartCollectionViewLocalData
+{
+    NSDictionary<NSNumber *, SmartCollectionViewItemMetadata *> *_itemsByIndex; // Built on first lookup
+    NSInteger _indexCount;
+}
 
 - (instancetype)initWithItems:(NSArray<SmartCollectionViewItemMetadata *> *)items
                        version:(NSInteger)version
@@ -42,6 +47,39 @@
     return self;
 }
 
+- (void)setItems:(NSArray<SmartCollectionViewItemMetadata *> *)items
+{
+    _items = items;
+    _itemsByIndex = nil;
+}
+
+- (void)buildIndexIfNeeded
+{
+    if (_itemsByIndex) {
+        return;
+    }
+    NSMutableDictionary<NSNumber *, SmartCollectionViewItemMetadata *> *itemsByIndex = [NSMutableDictionary dictionaryWithCapacity:_items.count];
+    NSInteger indexCount = 0;
+    for (SmartCollectionViewItemMetadata *item in _items) {
+        itemsByIndex[@(item.index)] = item;
+        indexCount = MAX(indexCount, item.index + 1);
+    }
+    _itemsByIndex = [itemsByIndex copy];
+    _indexCount = indexCount;
+}
+
+- (SmartCollectionViewItemMetadata *)itemAtIndex:(NSInteger)index
+{
+    [self buildIndexIfNeeded];
+    return _itemsByIndex[@(index)];
+}
+
+- (NSInteger)indexCount
+{
+    [self buildIndexIfNeeded];
+    return _indexCount;
+}
+
 - (id)copyWithZone:(NSZone *)zone
 {
     NSMutableArray *copiedItems = [NSMutableArray arrayWithCapacity:self.items.count];
@@ -38,16 +38,41 @@ RCT_EXPORT_VIEW_PROPERTY(maxToRenderPerBatch, NSInteger)
 RCT_EXPORT_VIEW_PROPERTY(overscanCount, NSInteger)
 RCT_EXPORT_VIEW_PROPERTY(overscanLength, CGFloat)
 RCT_EXPORT_VIEW_PROPERTY(shadowBufferMultiplier, CGFloat)
+RCT_EXPORT_VIEW_PROPERTY(predictiveWindowing, BOOL)
+RCT_EXPORT_VIEW_PROPERTY(maxVisibleRequestsPerBatch, NSInteger)
+RCT_EXPORT_VIEW_PROPERTY(maxMountBufferRequestsPerBatch, NSInteger)
+RCT_EXPORT_VIEW_PROPERTY(maxShadowRequestsPerBatch, NSInteger)
+RCT_EXPORT_VIEW_PROPERTY(adaptiveBatching, BOOL)
+RCT_EXPORT_VIEW_PROPERTY(frameBudget, CGFloat)
+RCT_EXPORT_VIEW_PROPERTY(itemTypes, NSStringArray)
+RCT_EXPORT_VIEW_PROPERTY(itemKeys, NSStringArray)
+RCT_EXPORT_SHADOW_PROPERTY(itemKeys, NSStringArray)
+RCT_EXPORT_VIEW_PROPERTY(persistentSizeCacheName, NSString)
+RCT_EXPORT_VIEW_PROPERTY(adaptiveShadowBuffer, BOOL)
+RCT_EXPORT_VIEW_PROPERTY(maxOutstandingRequests, NSInteger)
+RCT_EXPORT_VIEW_PROPERTY(acknowledgedGeneration, NSInteger)
+RCT_EXPORT_VIEW_PROPERTY(unmountDwellTime, CGFloat)
+RCT_EXPORT_VIEW_PROPERTY(visibleLayoutCacheBudget, NSInteger)
+RCT_EXPORT_VIEW_PROPERTY(bufferLayoutCacheBudget, NSInteger)
+RCT_EXPORT_VIEW_PROPERTY(coldLayoutCacheBudget, NSInteger)
 RCT_EXPORT_VIEW_PROPERTY(initialMaxToRenderPerBatch, NSInteger)
 RCT_EXPORT_VIEW_PROPERTY(initialOverscanCount, NSInteger)
 RCT_EXPORT_VIEW_PROPERTY(initialOverscanLength, CGFloat)
 RCT_EXPORT_VIEW_PROPERTY(initialShadowBufferMultiplier, CGFloat)
 RCT_EXPORT_VIEW_PROPERTY(horizontal, BOOL)
+RCT_EXPORT_SHADOW_PROPERTY(horizontal, BOOL)
+RCT_EXPORT_VIEW_PROPERTY(layoutType, NSString)
+RCT_EXPORT_SHADOW_PROPERTY(layoutType, NSString)
+RCT_EXPORT_VIEW_PROPERTY(rowCount, NSInteger)
+RCT_EXPORT_SHADOW_PROPERTY(rowCount, NSInteger)
+RCT_EXPORT_VIEW_PROPERTY(minimumItemWidth, CGFloat)
+RCT_EXPORT_VIEW_PROPERTY(stickyHeaderIndices, NSNumberArray)
 RCT_EXPORT_VIEW_PROPERTY(estimatedItemSize, CGSize)
 RCT_EXPORT_VIEW_PROPERTY(totalItemCount, NSInteger)
 
 // Export events
 RCT_EXPORT_VIEW_PROPERTY(onRequestItems, RCTDirectEventBlock)
+RCT_EXPORT_VIEW_PROPERTY(onCancelRequests, RCTDirectEventBlock)
 RCT_EXPORT_VIEW_PROPERTY(onVisibleRangeChange, RCTDirectEventBlock)
 RCT_EXPORT_VIEW_PROPERTY(onScroll, RCTDirectEventBlock)
 RCT_EXPORT_VIEW_PROPERTY(onScrollBeginDrag, RCTDirectEventBlock)
@@ -67,8 +92,9 @@ RCT_EXPORT_VIEW_PROPERTY(onScrollEndDecelerating, RCTDirectEventBlock)
     
     if ([parentView isKindOfClass:[SmartCollectionView class]]) {
         SmartCollectionView *smartView = (SmartCollectionView *)parentView;
-        SCVManagerLog(@"✅ insertReactSubview - Registering child at index %ld, subview tag: %@, parent tag: %@", (long)index, subview.reactTag, smartView.reactTag);
-        [smartView registerChildView:subview atIndex:index];
+        // The child carries its data index; index is only its position among rendered children
+        SCVManagerLog(@"✅ insertReactSubview - Registering child at position %ld, subview tag: %@, parent tag: %@", (long)index, subview.reactTag, smartView.reactTag);
+        [smartView registerChildView:subview];
     } else {
         SCVManagerLog(@"❌ ERROR: insertReactSubview - parent is not SmartCollectionView, got: %@", NSStringFromClass([parentView class]));
     }
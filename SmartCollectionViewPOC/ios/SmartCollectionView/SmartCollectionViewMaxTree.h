@@ -0,0 +1,24 @@
+#import <Foundation/Foundation.h>
+#import <CoreGraphics/CoreGraphics.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+// Running maximum over per-item values (item heights, column widths).
+// Backed by a segment tree in one contiguous buffer: a point update is
+// O(log n) and the overall maximum is O(1).
+@interface SmartCollectionViewMaxTree : NSObject
+
+@property (nonatomic, assign, readonly) NSInteger count;
+@property (nonatomic, assign, readonly) CGFloat maxValue; // 0 when empty
+
+// Rebuild from scratch in O(n)
+- (void)resetWithValues:(nullable const CGFloat *)values count:(NSInteger)count;
+- (void)removeAll;
+
+// Point update in O(log n). Returns NO if the value did not change.
+- (BOOL)setValue:(CGFloat)value atIndex:(NSInteger)index;
+- (CGFloat)valueAtIndex:(NSInteger)index; // O(1)
+
+@end
+
+NS_ASSUME_NONNULL_END
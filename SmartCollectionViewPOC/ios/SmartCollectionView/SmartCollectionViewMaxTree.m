@@ -0,0 +1,85 @@
+#import "SmartCollectionViewMaxTree.h"
+#import <stdlib.h>
+
+@implementation SmartCollectionViewMaxTree
+{
+    CGFloat *_tree;        // 1-based; leaves start at _leafCount
+    NSInteger _leafCount;  // power of two >= count
+}
+
+- (instancetype)init
+{
+    self = [super init];
+    if (self) {
+        _tree = NULL;
+        _leafCount = 0;
+        _count = 0;
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    free(_tree);
+}
+
+- (CGFloat)maxValue
+{
+    return _count > 0 ? _tree[1] : 0;
+}
+
+- (void)resetWithValues:(const CGFloat *)values count:(NSInteger)count
+{
+    count = MAX(0, count);
+    NSInteger leafCount = 1;
+    while (leafCount < count) {
+        leafCount *= 2;
+    }
+    if (leafCount != _leafCount) {
+        _tree = realloc(_tree, sizeof(CGFloat) * leafCount * 2);
+        _leafCount = leafCount;
+    }
+    _count = count;
+
+    for (NSInteger i = 0; i < leafCount; i++) {
+        _tree[leafCount + i] = (i < count && values) ? values[i] : 0;
+    }
+    for (NSInteger node = leafCount - 1; node >= 1; node--) {
+        _tree[node] = MAX(_tree[2 * node], _tree[2 * node + 1]);
+    }
+}
+
+- (void)removeAll
+{
+    [self resetWithValues:NULL count:0];
+}
+
+- (BOOL)setValue:(CGFloat)value atIndex:(NSInteger)index
+{
+    if (index < 0 || index >= _count) {
+        return NO;
+    }
+    NSInteger node = _leafCount + index;
+    if (_tree[node] == value) {
+        return NO;
+    }
+    _tree[node] = value;
+    for (node /= 2; node >= 1; node /= 2) {
+        CGFloat maxValue = MAX(_tree[2 * node], _tree[2 * node + 1]);
+        if (_tree[node] == maxValue) {
+            break; // Ancestors already hold the right max
+        }
+        _tree[node] = maxValue;
+    }
+    return YES;
+}
+
+- (CGFloat)valueAtIndex:(NSInteger)index
+{
+    if (index < 0 || index >= _count) {
+        return 0;
+    }
+    return _tree[_leafCount + index];
+}
+
+@end
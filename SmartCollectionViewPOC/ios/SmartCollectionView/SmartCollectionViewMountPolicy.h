@@ -0,0 +1,41 @@
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+// Result of one mount policy pass
+@interface SmartCollectionViewMountDecision : NSObject
+
+@property (nonatomic, strong, readonly) NSIndexSet *indicesToMount;    // Ready, inside the enter band, not mounted yet
+@property (nonatomic, strong, readonly) NSIndexSet *indicesToUnmount;  // Mounted, outside the exit band for at least the dwell time
+// Seconds until an item waiting out its dwell time may be unmounted; -1 when none is waiting
+@property (nonatomic, assign, readonly) NSTimeInterval nextEvaluationDelay;
+
+@end
+
+// Mount/unmount decisions with hysteresis.
+// An item mounts once it is ready and inside the enter band (the mount range).
+// It unmounts only after leaving the wider exit band: the enter band plus
+// exitMargin items on the trailing side, and exitMargin * leadingExitMultiplier
+// items on the side the scroll is heading toward. With a dwell time the item
+// must also stay outside the exit band that long, so small back-and-forth
+// scrolls at a window edge do not remount the same wrappers.
+@interface SmartCollectionViewMountPolicy : NSObject
+
+@property (nonatomic, assign) NSInteger exitMargin;              // Items kept mounted past the enter band (default: 2)
+@property (nonatomic, assign) CGFloat leadingExitMultiplier;     // Exit margin scale ahead of the scroll (default: 2.0)
+@property (nonatomic, assign) NSTimeInterval dwellTime;          // Seconds outside the exit band before unmounting (default: 0)
+
+// enterRange: mount range; pinnedRange: never unmounted (e.g. fling landing window)
+// direction: > 0 toward higher indices, < 0 toward lower, 0 idle
+- (SmartCollectionViewMountDecision *)decisionWithEnterRange:(NSRange)enterRange
+                                                 pinnedRange:(NSRange)pinnedRange
+                                                readyIndices:(NSIndexSet *)readyIndices
+                                              mountedIndices:(NSIndexSet *)mountedIndices
+                                                   direction:(NSInteger)direction
+                                                      atTime:(NSTimeInterval)time;
+// Forget dwell timers (content reset)
+- (void)reset;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,94 @@
+#import "SmartCollectionViewMountPolicy.h"
+#import <CoreGraphics/CoreGraphics.h>
+
+@interface SmartCollectionViewMountDecision ()
+
+@property (nonatomic, strong, readwrite) NSIndexSet *indicesToMount;
+@property (nonatomic, strong, readwrite) NSIndexSet *indicesToUnmount;
+@property (nonatomic, assign, readwrite) NSTimeInterval nextEvaluationDelay;
+
+@end
+
+@implementation SmartCollectionViewMountDecision
+@end
+
+@interface SmartCollectionViewMountPolicy ()
+
+// Index -> time it was first seen outside the exit band
+@property (nonatomic, strong) NSMutableDictionary<NSNumber *, NSNumber *> *exitTimes;
+
+@end
+
+@implementation SmartCollectionViewMountPolicy
+
+- (instancetype)init
+{
+    self = [super init];
+    if (self) {
+        _exitMargin = 2;
+        _leadingExitMultiplier = 2.0;
+        _dwellTime = 0;
+        _exitTimes = [NSMutableDictionary dictionary];
+    }
+    return self;
+}
+
+- (SmartCollectionViewMountDecision *)decisionWithEnterRange:(NSRange)enterRange
+                                                 pinnedRange:(NSRange)pinnedRange
+                                                readyIndices:(NSIndexSet *)readyIndices
+                                              mountedIndices:(NSIndexSet *)mountedIndices
+                                                   direction:(NSInteger)direction
+                                                      atTime:(NSTimeInterval)time
+{
+    NSMutableIndexSet *toMount = [NSMutableIndexSet indexSet];
+    [readyIndices enumerateIndexesUsingBlock:^(NSUInteger index, BOOL *stop) {
+        if ((NSLocationInRange(index, enterRange) || NSLocationInRange(index, pinnedRange)) &&
+            ![mountedIndices containsIndex:index]) {
+            [toMount addIndex:index];
+        }
+    }];
+
+    // Exit band: wider than the enter band, widest on the side the scroll is heading toward
+    NSInteger margin = MAX(0, self.exitMargin);
+    NSInteger leadingMargin = (NSInteger)ceil(margin * MAX(1.0, self.leadingExitMultiplier));
+    NSInteger marginBefore = (direction < 0) ? leadingMargin : margin;
+    NSInteger marginAfter = (direction > 0) ? leadingMargin : margin;
+    NSInteger exitStart = (NSInteger)enterRange.location - marginBefore;
+    NSInteger exitEnd = (NSInteger)NSMaxRange(enterRange) + marginAfter;
+
+    NSMutableIndexSet *toUnmount = [NSMutableIndexSet indexSet];
+    NSMutableDictionary<NSNumber *, NSNumber *> *exitTimes = [NSMutableDictionary dictionary];
+    __block NSTimeInterval nextDelay = -1;
+    NSTimeInterval dwellTime = MAX(0, self.dwellTime);
+    [mountedIndices enumerateIndexesUsingBlock:^(NSUInteger mountedIndex, BOOL *stop) {
+        NSInteger index = (NSInteger)mountedIndex;
+        if (NSLocationInRange(mountedIndex, pinnedRange) || (index >= exitStart && index < exitEnd)) {
+            return;
+        }
+        NSNumber *key = @(mountedIndex);
+        NSNumber *since = self.exitTimes[key];
+        NSTimeInterval exitTime = since ? since.doubleValue : time;
+        NSTimeInterval remaining = dwellTime - (time - exitTime);
+        if (remaining <= 0) {
+            [toUnmount addIndex:mountedIndex];
+            return;
+        }
+        // Still dwelling; timers of items back inside the band are dropped with the old dictionary
+        exitTimes[key] = @(exitTime);
+        nextDelay = (nextDelay < 0) ? remaining : MIN(nextDelay, remaining);
+    }];
+    self.exitTimes = exitTimes;
+
+    SmartCollectionViewMountDecision *decision = [[SmartCollectionViewMountDecision alloc] init];
+    decision.indicesToMount = toMount;
+    decision.indicesToUnmount = toUnmount;
+    decision.nextEvaluationDelay = nextDelay;
+    return decision;
+}
+
+- (void)reset
+{
+    [self.exitTimes removeAllObjects];
+}
+
+@end
@@ -0,0 +1,36 @@
+#import <Foundation/Foundation.h>
+#import <CoreGraphics/CoreGraphics.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+// Prefix-sum index over item lengths along the scroll axis.
+// Backed by a Fenwick tree over a contiguous CGFloat buffer, so a single
+// item resize, offset lookup and offset->index search are all O(log n).
+@interface SmartCollectionViewOffsetIndex : NSObject
+
+@property (nonatomic, assign, readonly) NSInteger count;
+@property (nonatomic, assign, readonly) CGFloat totalLength;
+// Bumped on every mutation so callers can cheaply detect stale derived state
+@property (nonatomic, assign, readonly) NSUInteger mutationCount;
+
+// Rebuild from scratch in O(n)
+- (void)resetWithLengths:(const CGFloat *)lengths count:(NSInteger)count;
+- (void)removeAll;
+
+// Adds an item after the last one in O(log n) amortized
+- (void)appendLength:(CGFloat)length;
+
+// Point update in O(log n). Returns NO if the length did not change.
+- (BOOL)setLength:(CGFloat)length atIndex:(NSInteger)index;
+- (CGFloat)lengthAtIndex:(NSInteger)index; // O(1)
+
+// Start offset of the item at index (index == count returns totalLength)
+- (CGFloat)offsetAtIndex:(NSInteger)index;
+// End offset of the item at index
+- (CGFloat)endOffsetAtIndex:(NSInteger)index;
+// First index whose end offset is greater than offset (count if offset >= totalLength)
+- (NSInteger)indexForOffset:(CGFloat)offset;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,187 @@
+#import "SmartCollectionViewOffsetIndex.h"
+#import <stdlib.h>
+#import <string.h>
+
+@implementation SmartCollectionViewOffsetIndex
+{
+    CGFloat *_lengths;   // raw item lengths, 0-based
+    CGFloat *_tree;      // Fenwick tree, 1-based (slot 0 unused)
+    NSInteger _capacity;
+    NSInteger _highBit;  // highest power of two <= count, used by indexForOffset
+}
+
+- (instancetype)init
+{
+    self = [super init];
+    if (self) {
+        _lengths = NULL;
+        _tree = NULL;
+        _capacity = 0;
+        _count = 0;
+        _highBit = 0;
+        _totalLength = 0;
+        _mutationCount = 0;
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    free(_lengths);
+    free(_tree);
+}
+
+#pragma mark - Storage
+
+- (void)ensureCapacity:(NSInteger)capacity
+{
+    if (capacity <= _capacity) {
+        return;
+    }
+    NSInteger newCapacity = MAX(capacity, MAX(64, _capacity * 2));
+    _lengths = realloc(_lengths, sizeof(CGFloat) * newCapacity);
+    _tree = realloc(_tree, sizeof(CGFloat) * (newCapacity + 1));
+    _capacity = newCapacity;
+}
+
+- (void)updateHighBit
+{
+    _highBit = 1;
+    while (_highBit * 2 <= _count) {
+        _highBit *= 2;
+    }
+    if (_count == 0) {
+        _highBit = 0;
+    }
+}
+
+#pragma mark - Mutation
+
+- (void)resetWithLengths:(const CGFloat *)lengths count:(NSInteger)count
+{
+    count = MAX(0, count);
+    [self ensureCapacity:count];
+    _count = count;
+    _totalLength = 0;
+
+    if (count > 0) {
+        memcpy(_lengths, lengths, sizeof(CGFloat) * count);
+        // O(n) bottom-up construction: each node pushes its sum to its parent
+        _tree[0] = 0;
+        for (NSInteger i = 1; i <= count; i++) {
+            _tree[i] = _lengths[i - 1];
+        }
+        for (NSInteger i = 1; i <= count; i++) {
+            NSInteger parent = i + (i & -i);
+            if (parent <= count) {
+                _tree[parent] += _tree[i];
+            }
+        }
+        for (NSInteger i = 0; i < count; i++) {
+            _totalLength += _lengths[i];
+        }
+    }
+
+    [self updateHighBit];
+    _mutationCount++;
+}
+
+- (void)removeAll
+{
+    _count = 0;
+    _totalLength = 0;
+    _highBit = 0;
+    _mutationCount++;
+}
+
+- (void)appendLength:(CGFloat)length
+{
+    [self ensureCapacity:_count + 1];
+    _lengths[_count] = length;
+
+    // Node i covers (i - lowbit(i), i]: the new length plus the part of that
+    // span already in the tree, summed over at most log n existing nodes
+    NSInteger node = _count + 1;
+    NSInteger lower = node - (node & -node);
+    CGFloat sum = length;
+    for (NSInteger i = node - 1; i > lower; i -= (i & -i)) {
+        sum += _tree[i];
+    }
+    _tree[node] = sum;
+
+    _count++;
+    _totalLength += length;
+    if (_highBit == 0 || _highBit * 2 <= _count) {
+        [self updateHighBit];
+    }
+    _mutationCount++;
+}
+
+- (BOOL)setLength:(CGFloat)length atIndex:(NSInteger)index
+{
+    if (index < 0 || index >= _count) {
+        return NO;
+    }
+    CGFloat delta = length - _lengths[index];
+    if (delta == 0) {
+        return NO;
+    }
+    _lengths[index] = length;
+    for (NSInteger i = index + 1; i <= _count; i += (i & -i)) {
+        _tree[i] += delta;
+    }
+    _totalLength += delta;
+    _mutationCount++;
+    return YES;
+}
+
+#pragma mark - Queries
+
+- (CGFloat)lengthAtIndex:(NSInteger)index
+{
+    if (index < 0 || index >= _count) {
+        return 0;
+    }
+    return _lengths[index];
+}
+
+- (CGFloat)offsetAtIndex:(NSInteger)index
+{
+    if (index <= 0) {
+        return 0;
+    }
+    if (index >= _count) {
+        return _totalLength;
+    }
+    CGFloat sum = 0;
+    for (NSInteger i = index; i > 0; i -= (i & -i)) {
+        sum += _tree[i];
+    }
+    return sum;
+}
+
+- (CGFloat)endOffsetAtIndex:(NSInteger)index
+{
+    return [self offsetAtIndex:index + 1];
+}
+
+- (NSInteger)indexForOffset:(CGFloat)offset
+{
+    if (_count == 0 || offset < 0) {
+        return 0;
+    }
+    // Fenwick descent: find the largest prefix whose sum is <= offset.
+    // Lengths are non-negative so prefix sums are monotonic.
+    NSInteger position = 0;
+    CGFloat remaining = offset;
+    for (NSInteger step = _highBit; step > 0; step >>= 1) {
+        NSInteger next = position + step;
+        if (next <= _count && _tree[next] <= remaining) {
+            position = next;
+            remaining -= _tree[next];
+        }
+    }
+    return position;
+}
+
+@end
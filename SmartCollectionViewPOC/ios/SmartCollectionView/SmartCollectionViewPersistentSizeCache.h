@@ -0,0 +1,39 @@
+#import <Foundation/Foundation.h>
+#import <CoreGraphics/CoreGraphics.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+// Measured item sizes that survive relaunches.
+// Entries are keyed by (item key, item type, layout width) and live in a
+// memory-mapped file: a versioned header followed by an open-addressed table
+// of 16-byte slots. The file is mapped on first use, so a warm start seeds
+// exact sizes without reading or parsing anything up front.
+// Slots are updated in place; growing and compaction rewrite the table into a
+// temporary file and rename it over the old one, so a crash leaves either the
+// old or the new table. A file with a foreign header is discarded.
+@interface SmartCollectionViewPersistentSizeCache : NSObject
+
+@property (nonatomic, copy, readonly) NSString *path;
+@property (nonatomic, assign, readonly) NSUInteger count; // Stored entries (maps the file if needed)
+
+// File in Library/Caches/SmartCollectionView named after the cache
++ (NSString *)pathForCacheName:(NSString *)name;
+
+// The file is created on the first write
+- (instancetype)initWithPath:(NSString *)path NS_DESIGNATED_INITIALIZER;
+- (instancetype)init NS_UNAVAILABLE;
+
+// width: list width the item was laid out against (the cross axis of vertical
+// lists, the percentage base of horizontal ones); rounded to whole points
+- (BOOL)getSize:(CGSize * _Nullable)size forKey:(NSString *)key itemType:(nullable NSString *)itemType layoutWidth:(CGFloat)width;
+- (void)setSize:(CGSize)size forKey:(NSString *)key itemType:(nullable NSString *)itemType layoutWidth:(CGFloat)width;
+
+// Rewrites the table at the smallest capacity that fits the stored entries
+- (void)compact;
+// Schedules dirty pages to be written back
+- (void)synchronize;
+- (void)removeAll;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,319 @@
+#import "SmartCollectionViewPersistentSizeCache.h"
+#import <sys/mman.h>
+#import <sys/stat.h>
+#import <fcntl.h>
+#import <unistd.h>
+#import <string.h>
+#import <math.h>
+
+static const uint32_t kFileMagic = 0x53435653; // 'SCVS'
+static const uint32_t kFileVersion = 1;
+static const uint64_t kMinCapacity = 1024;     // Slots; always a power of two
+static const double kMaxLoadFactor = 0.7;
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t entrySize;
+    uint32_t reserved;
+    uint64_t capacity;
+    uint64_t count;
+} SCVSizeFileHeader;
+
+// hash == 0 marks an empty slot. Sizes are written before the hash, so a slot
+// is never visible with a half-written size.
+typedef struct {
+    uint64_t hash;
+    float width;
+    float height;
+} SCVSizeFileEntry;
+
+static uint64_t SCVHashBytes(uint64_t hash, const void *bytes, size_t length)
+{
+    // FNV-1a
+    const uint8_t *p = bytes;
+    for (size_t i = 0; i < length; i++) {
+        hash ^= p[i];
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+// 64-bit identity of (key, type, width); a collision aliases two items, which
+// at worst seeds one with the other's size until it is measured
+static uint64_t SCVEntryHash(NSString *key, NSString *itemType, CGFloat width)
+{
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    const char *keyBytes = key.UTF8String ?: "";
+    hash = SCVHashBytes(hash, keyBytes, strlen(keyBytes) + 1);
+    const char *typeBytes = itemType.UTF8String ?: "";
+    hash = SCVHashBytes(hash, typeBytes, strlen(typeBytes) + 1);
+    int64_t roundedWidth = (int64_t)lround(width);
+    hash = SCVHashBytes(hash, &roundedWidth, sizeof(roundedWidth));
+    return hash != 0 ? hash : 1;
+}
+
+static size_t SCVFileLength(uint64_t capacity)
+{
+    return sizeof(SCVSizeFileHeader) + (size_t)capacity * sizeof(SCVSizeFileEntry);
+}
+
+// Slot holding hash, or the empty slot where it would go
+static SCVSizeFileEntry *SCVFindSlot(SCVSizeFileEntry *entries, uint64_t capacity, uint64_t hash)
+{
+    uint64_t mask = capacity - 1;
+    for (uint64_t slot = hash & mask;; slot = (slot + 1) & mask) {
+        if (entries[slot].hash == hash || entries[slot].hash == 0) {
+            return &entries[slot];
+        }
+    }
+}
+
+@implementation SmartCollectionViewPersistentSizeCache
+{
+    int _fd;
+    void *_mapping;
+    size_t _mappedLength;
+    BOOL _loaded; // Open attempted; the file may still not exist
+}
+
++ (NSString *)pathForCacheName:(NSString *)name
+{
+    NSString *caches = NSSearchPathForDirectoriesInDomains(NSCachesDirectory, NSUserDomainMask, YES).firstObject ?: NSTemporaryDirectory();
+    NSString *directory = [caches stringByAppendingPathComponent:@"SmartCollectionView"];
+    return [[directory stringByAppendingPathComponent:name] stringByAppendingPathExtension:@"sizes"];
+}
+
+- (instancetype)initWithPath:(NSString *)path
+{
+    self = [super init];
+    if (self) {
+        _path = [path copy];
+        _fd = -1;
+        _mapping = NULL;
+        _mappedLength = 0;
+        _loaded = NO;
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    [self unmap];
+}
+
+#pragma mark - Mapping
+
+- (SCVSizeFileHeader *)header
+{
+    return (SCVSizeFileHeader *)_mapping;
+}
+
+- (SCVSizeFileEntry *)entries
+{
+    return (SCVSizeFileEntry *)((uint8_t *)_mapping + sizeof(SCVSizeFileHeader));
+}
+
+- (void)unmap
+{
+    if (_mapping) {
+        munmap(_mapping, _mappedLength);
+        _mapping = NULL;
+        _mappedLength = 0;
+    }
+    if (_fd >= 0) {
+        close(_fd);
+        _fd = -1;
+    }
+}
+
+- (BOOL)mapFileAtPath:(NSString *)path
+{
+    int fd = open(path.fileSystemRepresentation, O_RDWR);
+    if (fd < 0) {
+        return NO;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || (size_t)info.st_size < sizeof(SCVSizeFileHeader)) {
+        close(fd);
+        return NO;
+    }
+    void *mapping = mmap(NULL, (size_t)info.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (mapping == MAP_FAILED) {
+        close(fd);
+        return NO;
+    }
+
+    const SCVSizeFileHeader *header = mapping;
+    BOOL valid = header->magic == kFileMagic
+        && header->version == kFileVersion
+        && header->entrySize == sizeof(SCVSizeFileEntry)
+        && header->capacity >= kMinCapacity
+        && (header->capacity & (header->capacity - 1)) == 0
+        && SCVFileLength(header->capacity) == (size_t)info.st_size
+        && header->count < header->capacity;
+    if (!valid) {
+        munmap(mapping, (size_t)info.st_size);
+        close(fd);
+        return NO;
+    }
+
+    [self unmap];
+    _fd = fd;
+    _mapping = mapping;
+    _mappedLength = (size_t)info.st_size;
+    return YES;
+}
+
+// Maps the existing file once; a missing or foreign file reads as empty
+- (void)loadIfNeeded
+{
+    if (_loaded) {
+        return;
+    }
+    _loaded = YES;
+    if (![self mapFileAtPath:self.path]) {
+        [[NSFileManager defaultManager] removeItemAtPath:self.path error:nil];
+    }
+}
+
+// Writes a table of the given capacity holding the current entries to a
+// temporary file, then renames it over the cache file and maps it
+- (BOOL)rewriteWithCapacity:(uint64_t)capacity
+{
+    NSString *directory = [self.path stringByDeletingLastPathComponent];
+    [[NSFileManager defaultManager] createDirectoryAtPath:directory withIntermediateDirectories:YES attributes:nil error:nil];
+    NSString *temporaryPath = [self.path stringByAppendingString:@".tmp"];
+
+    int fd = open(temporaryPath.fileSystemRepresentation, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        return NO;
+    }
+    size_t length = SCVFileLength(capacity);
+    if (ftruncate(fd, (off_t)length) != 0) {
+        close(fd);
+        unlink(temporaryPath.fileSystemRepresentation);
+        return NO;
+    }
+    void *mapping = mmap(NULL, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (mapping == MAP_FAILED) {
+        close(fd);
+        unlink(temporaryPath.fileSystemRepresentation);
+        return NO;
+    }
+
+    // ftruncate zero-fills, so every slot starts empty
+    SCVSizeFileHeader *header = mapping;
+    SCVSizeFileEntry *entries = (SCVSizeFileEntry *)((uint8_t *)mapping + sizeof(SCVSizeFileHeader));
+    uint64_t count = 0;
+    if (_mapping) {
+        SCVSizeFileEntry *oldEntries = [self entries];
+        uint64_t oldCapacity = [self header]->capacity;
+        for (uint64_t i = 0; i < oldCapacity; i++) {
+            if (oldEntries[i].hash != 0) {
+                *SCVFindSlot(entries, capacity, oldEntries[i].hash) = oldEntries[i];
+                count++;
+            }
+        }
+    }
+    header->entrySize = sizeof(SCVSizeFileEntry);
+    header->capacity = capacity;
+    header->count = count;
+    header->version = kFileVersion;
+    header->magic = kFileMagic; // Last: the file is not valid until its table is complete
+
+    BOOL written = msync(mapping, length, MS_SYNC) == 0
+        && rename(temporaryPath.fileSystemRepresentation, self.path.fileSystemRepresentation) == 0;
+    munmap(mapping, length);
+    close(fd);
+    if (!written) {
+        unlink(temporaryPath.fileSystemRepresentation);
+        return NO;
+    }
+    return [self mapFileAtPath:self.path];
+}
+
+#pragma mark - Access
+
+- (NSUInteger)count
+{
+    [self loadIfNeeded];
+    return _mapping ? (NSUInteger)[self header]->count : 0;
+}
+
+- (BOOL)getSize:(CGSize *)size forKey:(NSString *)key itemType:(NSString *)itemType layoutWidth:(CGFloat)width
+{
+    [self loadIfNeeded];
+    if (!_mapping) {
+        return NO;
+    }
+    SCVSizeFileEntry *entry = SCVFindSlot([self entries], [self header]->capacity, SCVEntryHash(key, itemType, width));
+    if (entry->hash == 0) {
+        return NO;
+    }
+    if (size) {
+        *size = CGSizeMake(entry->width, entry->height);
+    }
+    return YES;
+}
+
+- (void)setSize:(CGSize)size forKey:(NSString *)key itemType:(NSString *)itemType layoutWidth:(CGFloat)width
+{
+    if (size.width <= 0 || size.height <= 0) {
+        return;
+    }
+    [self loadIfNeeded];
+    if (!_mapping && ![self rewriteWithCapacity:kMinCapacity]) {
+        return;
+    }
+
+    uint64_t hash = SCVEntryHash(key, itemType, width);
+    SCVSizeFileEntry *entry = SCVFindSlot([self entries], [self header]->capacity, hash);
+    if (entry->hash == 0) {
+        SCVSizeFileHeader *header = [self header];
+        if ((double)(header->count + 1) > (double)header->capacity * kMaxLoadFactor) {
+            if (![self rewriteWithCapacity:header->capacity * 2]) {
+                return;
+            }
+            entry = SCVFindSlot([self entries], [self header]->capacity, hash);
+        }
+        entry->width = (float)size.width;
+        entry->height = (float)size.height;
+        entry->hash = hash;
+        [self header]->count += 1;
+    } else {
+        entry->width = (float)size.width;
+        entry->height = (float)size.height;
+    }
+}
+
+- (void)compact
+{
+    [self loadIfNeeded];
+    if (!_mapping) {
+        return;
+    }
+    uint64_t capacity = kMinCapacity;
+    while ((double)[self header]->count > (double)capacity * kMaxLoadFactor / 2) {
+        capacity *= 2;
+    }
+    if (capacity < [self header]->capacity) {
+        [self rewriteWithCapacity:capacity];
+    }
+}
+
+- (void)synchronize
+{
+    if (_mapping) {
+        msync(_mapping, _mappedLength, MS_ASYNC);
+    }
+}
+
+- (void)removeAll
+{
+    [self unmap];
+    [[NSFileManager defaultManager] removeItemAtPath:self.path error:nil];
+    _loaded = YES;
+}
+
+@end
@@ -0,0 +1,31 @@
+#import <Foundation/Foundation.h>
+#import <CoreGraphics/CoreGraphics.h>
+
+@class SmartCollectionViewOffsetIndex;
+
+NS_ASSUME_NONNULL_BEGIN
+
+// Stateful visible-range lookup over an offset index.
+// Each update gallops from the previous range one item at a time, so small
+// scroll deltas cost O(1); long jumps or a mutated index fall back to the
+// O(log n) search on the offset index.
+@interface SmartCollectionViewRangeTracker : NSObject
+
+@property (nonatomic, strong, readonly) SmartCollectionViewOffsetIndex *offsetIndex;
+@property (nonatomic, assign, readonly) NSRange range;
+// Steps per edge before giving up and searching the index (default: 8)
+@property (nonatomic, assign) NSInteger maxGallopSteps;
+
+- (instancetype)initWithOffsetIndex:(SmartCollectionViewOffsetIndex *)offsetIndex NS_DESIGNATED_INITIALIZER;
+- (instancetype)init NS_UNAVAILABLE;
+
+// Items intersecting [startOffset, endOffset). changed is set to NO when the
+// result equals the previous range.
+- (NSRange)rangeForStartOffset:(CGFloat)startOffset
+                     endOffset:(CGFloat)endOffset
+                       changed:(nullable BOOL *)changed;
+- (void)invalidate;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,150 @@
+#import "SmartCollectionViewRangeTracker.h"
+#import "SmartCollectionViewOffsetIndex.h"
+
+// Galloping accumulates offsets by add/subtract; re-anchor on the index periodically
+static const NSUInteger kResyncInterval = 256;
+
+// Moves *cursor to the first item whose end offset is greater than target.
+// *cursorOffset is the start offset of the item at *cursor (totalLength at count).
+// Returns NO when more than maxSteps moves would be needed.
+static BOOL SCVGallopEdge(SmartCollectionViewOffsetIndex *offsetIndex,
+                          NSInteger count,
+                          CGFloat target,
+                          NSInteger maxSteps,
+                          NSInteger *cursor,
+                          CGFloat *cursorOffset)
+{
+    NSInteger index = *cursor;
+    CGFloat offset = *cursorOffset;
+    NSInteger steps = 0;
+
+    // Forward: the item at the cursor ends at or before target
+    while (index < count) {
+        CGFloat length = [offsetIndex lengthAtIndex:index];
+        if (offset + length > target) {
+            break;
+        }
+        if (++steps > maxSteps) {
+            return NO;
+        }
+        offset += length;
+        index++;
+    }
+
+    // Backward: the previous item still ends past target
+    while (index > 0 && offset > target) {
+        if (++steps > maxSteps) {
+            return NO;
+        }
+        index--;
+        offset -= [offsetIndex lengthAtIndex:index];
+    }
+
+    *cursor = index;
+    *cursorOffset = offset;
+    return YES;
+}
+
+@interface SmartCollectionViewRangeTracker ()
+
+@property (nonatomic, strong, readwrite) SmartCollectionViewOffsetIndex *offsetIndex;
+@property (nonatomic, assign, readwrite) NSRange range;
+
+@end
+
+@implementation SmartCollectionViewRangeTracker {
+    BOOL _valid;
+    NSInteger _trackedCount;
+    NSUInteger _trackedMutation;
+    NSUInteger _updatesSinceResync;
+
+    // Unclamped search results (0...count) for each edge and their start offsets
+    NSInteger _startCursor;
+    CGFloat _startCursorOffset;
+    NSInteger _endCursor;
+    CGFloat _endCursorOffset;
+}
+
+- (instancetype)initWithOffsetIndex:(SmartCollectionViewOffsetIndex *)offsetIndex
+{
+    NSParameterAssert(offsetIndex);
+
+    self = [super init];
+    if (self) {
+        _offsetIndex = offsetIndex;
+        _range = NSMakeRange(0, 0);
+        _maxGallopSteps = 8;
+        _valid = NO;
+    }
+    return self;
+}
+
+- (void)invalidate
+{
+    _valid = NO;
+}
+
+- (void)seekStart:(CGFloat)startOffset end:(CGFloat)endOffset
+{
+    SmartCollectionViewOffsetIndex *offsetIndex = self.offsetIndex;
+    _startCursor = [offsetIndex indexForOffset:startOffset];
+    _startCursorOffset = [offsetIndex offsetAtIndex:_startCursor];
+    _endCursor = [offsetIndex indexForOffset:endOffset];
+    _endCursorOffset = [offsetIndex offsetAtIndex:_endCursor];
+    _updatesSinceResync = 0;
+}
+
+- (NSRange)rangeForStartOffset:(CGFloat)startOffset
+                     endOffset:(CGFloat)endOffset
+                       changed:(BOOL *)changed
+{
+    SmartCollectionViewOffsetIndex *offsetIndex = self.offsetIndex;
+    NSInteger count = offsetIndex.count;
+    NSRange previous = self.range;
+
+    if (count <= 0) {
+        _valid = NO;
+        self.range = NSMakeRange(0, 0);
+        if (changed) {
+            *changed = !NSEqualRanges(previous, self.range);
+        }
+        return self.range;
+    }
+
+    BOOL stale = !_valid || _trackedCount != count || _trackedMutation != offsetIndex.mutationCount;
+    if (stale || _updatesSinceResync >= kResyncInterval) {
+        [self seekStart:startOffset end:endOffset];
+    } else {
+        NSInteger maxSteps = MAX(0, self.maxGallopSteps);
+        BOOL startFound = SCVGallopEdge(offsetIndex, count, startOffset, maxSteps, &_startCursor, &_startCursorOffset);
+        BOOL endFound = startFound && SCVGallopEdge(offsetIndex, count, endOffset, maxSteps, &_endCursor, &_endCursorOffset);
+        if (!endFound) {
+            // Jumped further than a few items (fling, scrollTo); search instead
+            [self seekStart:startOffset end:endOffset];
+        }
+    }
+    _valid = YES;
+    _trackedCount = count;
+    _trackedMutation = offsetIndex.mutationCount;
+
+    // Same clamping as a fresh search in the scheduler
+    NSInteger startIndex = MIN(_startCursor, count - 1);
+    NSInteger endIndex = _endCursor;
+    if (endIndex < count && _endCursorOffset < endOffset) {
+        endIndex += 1;
+    }
+    endIndex = MAX(startIndex, MIN(endIndex, count));
+
+    NSRange range = NSMakeRange(startIndex, endIndex - startIndex);
+    BOOL didChange = !NSEqualRanges(previous, range);
+    if (didChange) {
+        _updatesSinceResync++;
+    }
+    self.range = range;
+    if (changed) {
+        *changed = didChange;
+    }
+    return range;
+}
+
+@end
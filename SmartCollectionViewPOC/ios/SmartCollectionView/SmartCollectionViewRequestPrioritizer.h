@@ -0,0 +1,28 @@
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+// Orders outstanding item requests into lanes: visible items, then the mount
+// buffer, then the shadow (request-only) buffer. Within the buffer lanes,
+// items are emitted by distance from the viewport edge, leading edge of the
+// scroll first; with no direction both sides are interleaved.
+@interface SmartCollectionViewRequestPrioritizer : NSObject
+
+// Per-lane caps per batch; 0 = no lane cap (only the overall limit applies)
+@property (nonatomic, assign) NSInteger visibleLaneCap;
+@property (nonatomic, assign) NSInteger mountBufferLaneCap;
+@property (nonatomic, assign) NSInteger shadowLaneCap;
+
+// candidates: indices that still need requesting (anything outside requestRange is ignored)
+// direction: > 0 toward higher indices, < 0 toward lower, 0 idle
+// limit: overall batch size; 0 = unlimited
+- (NSArray<NSNumber *> *)orderedRequestsForCandidates:(NSIndexSet *)candidates
+                                         visibleRange:(NSRange)visibleRange
+                                           mountRange:(NSRange)mountRange
+                                         requestRange:(NSRange)requestRange
+                                            direction:(NSInteger)direction
+                                                limit:(NSUInteger)limit;
+
+@end
+
+NS_ASSUME_NONNULL_END
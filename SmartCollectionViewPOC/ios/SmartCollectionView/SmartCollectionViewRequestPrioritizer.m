@@ -0,0 +1,107 @@
+#import "SmartCollectionViewRequestPrioritizer.h"
+
+static NSUInteger SCVEffectiveCap(NSInteger cap)
+{
+    return cap > 0 ? (NSUInteger)cap : NSUIntegerMax;
+}
+
+@implementation SmartCollectionViewRequestPrioritizer
+
+- (instancetype)init
+{
+    self = [super init];
+    if (self) {
+        _visibleLaneCap = 0;
+        _mountBufferLaneCap = 0;
+        _shadowLaneCap = 0;
+    }
+    return self;
+}
+
+- (NSArray<NSNumber *> *)orderedRequestsForCandidates:(NSIndexSet *)candidates
+                                         visibleRange:(NSRange)visibleRange
+                                           mountRange:(NSRange)mountRange
+                                         requestRange:(NSRange)requestRange
+                                            direction:(NSInteger)direction
+                                                limit:(NSUInteger)limit
+{
+    NSMutableArray<NSNumber *> *ordered = [NSMutableArray array];
+    if (candidates.count == 0) {
+        return ordered;
+    }
+    NSUInteger overallLimit = limit > 0 ? limit : NSUIntegerMax;
+
+    // Visible lane: start at the edge items are scrolling in from
+    NSUInteger visibleCap = SCVEffectiveCap(self.visibleLaneCap);
+    NSUInteger taken = 0;
+    for (NSUInteger step = 0; step < visibleRange.length; step++) {
+        if (taken >= visibleCap || ordered.count >= overallLimit) {
+            break;
+        }
+        NSUInteger index = (direction > 0) ? NSMaxRange(visibleRange) - 1 - step : visibleRange.location + step;
+        if ([candidates containsIndex:index]) {
+            [ordered addObject:@(index)];
+            taken++;
+        }
+    }
+
+    [self appendRingWithInner:visibleRange
+                        outer:mountRange
+                   candidates:candidates
+                    direction:direction
+                          cap:SCVEffectiveCap(self.mountBufferLaneCap)
+                        limit:overallLimit
+                         into:ordered];
+    [self appendRingWithInner:mountRange
+                        outer:requestRange
+                   candidates:candidates
+                    direction:direction
+                          cap:SCVEffectiveCap(self.shadowLaneCap)
+                        limit:overallLimit
+                         into:ordered];
+    return ordered;
+}
+
+// Appends candidates in outer but not inner, nearest to inner first
+- (void)appendRingWithInner:(NSRange)inner
+                      outer:(NSRange)outer
+                 candidates:(NSIndexSet *)candidates
+                  direction:(NSInteger)direction
+                        cap:(NSUInteger)cap
+                      limit:(NSUInteger)limit
+                       into:(NSMutableArray<NSNumber *> *)ordered
+{
+    NSInteger afterIndex = MAX((NSInteger)NSMaxRange(inner), (NSInteger)outer.location);
+    NSInteger afterEnd = (NSInteger)NSMaxRange(outer);
+    NSInteger beforeIndex = MIN((NSInteger)inner.location, (NSInteger)NSMaxRange(outer)) - 1;
+    NSInteger beforeEnd = (NSInteger)outer.location;
+
+    NSUInteger taken = 0;
+    BOOL preferAfter = YES;
+    while (taken < cap && ordered.count < limit) {
+        BOOL hasAfter = afterIndex < afterEnd;
+        BOOL hasBefore = beforeIndex >= beforeEnd;
+        if (!hasAfter && !hasBefore) {
+            break;
+        }
+
+        BOOL takeAfter;
+        if (direction > 0) {
+            takeAfter = hasAfter;
+        } else if (direction < 0) {
+            takeAfter = !hasBefore;
+        } else {
+            // Idle: alternate sides so both edges fill at the same distance
+            takeAfter = hasAfter && (!hasBefore || preferAfter);
+            preferAfter = !preferAfter;
+        }
+
+        NSInteger index = takeAfter ? afterIndex++ : beforeIndex--;
+        if ([candidates containsIndex:(NSUInteger)index]) {
+            [ordered addObject:@(index)];
+            taken++;
+        }
+    }
+}
+
+@end
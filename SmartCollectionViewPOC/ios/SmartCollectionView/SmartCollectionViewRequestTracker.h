@@ -0,0 +1,42 @@
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+typedef NSTimeInterval (^SmartCollectionViewClock)(void);
+
+// Lifecycle of item requests sent to JS.
+// Every batch gets a generation number and a timestamp, and is dropped once
+// all of its indices are rendered, cancelled or re-requested. Requests that
+// JS never answers expire after `timeout` and become eligible for a retry;
+// after `maxRetries` the index is abandoned until it leaves the window.
+// Requests that fall outside the current window are cancelled.
+// A retried index may be one JS has already rendered whose child never
+// registered; the JS wrapper remounts such an index under a fresh key.
+@interface SmartCollectionViewRequestTracker : NSObject
+
+// Time source; defaults to CACurrentMediaTime. Replace for deterministic timing.
+@property (nonatomic, copy) SmartCollectionViewClock clock;
+@property (nonatomic, assign) NSTimeInterval timeout;   // seconds (default: 1.0)
+@property (nonatomic, assign) NSInteger maxRetries;     // re-requests per index before giving up (default: 3)
+
+@property (nonatomic, assign, readonly) NSUInteger generation;         // Generation of the latest batch
+@property (nonatomic, strong, readonly) NSIndexSet *pendingIndices;    // Requested, not rendered yet
+@property (nonatomic, strong, readonly) NSIndexSet *abandonedIndices;  // Out of retries; not requested again while in window
+
+// Records a batch and returns its generation
+- (NSUInteger)beginRequestForIndices:(NSIndexSet *)indices;
+// Returns seconds since the index was requested, or -1 if it was not pending
+- (NSTimeInterval)completeIndex:(NSInteger)index;
+
+// Drops requests older than timeout; returns the indices that may be requested again.
+// Adds the generation of every batch that still had a pending index to expiredGenerations
+- (NSIndexSet *)expireRequestsCollectingGenerations:(nullable NSMutableIndexSet *)expiredGenerations;
+// Cancels pending requests outside window and returns them; also forgets abandoned indices outside window
+- (NSIndexSet *)cancelRequestsOutsideIndexes:(NSIndexSet *)window;
+// Seconds until the oldest pending request expires, or -1 when nothing is pending
+- (NSTimeInterval)timeUntilNextExpiry;
+- (void)removeAll;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,221 @@
+#import "SmartCollectionViewRequestTracker.h"
+#import <QuartzCore/QuartzCore.h>
+
+// One onRequestItems emission
+@interface SmartCollectionViewRequestBatch : NSObject
+@property (nonatomic, assign) NSUInteger generation;
+@property (nonatomic, assign) NSTimeInterval timestamp;
+@property (nonatomic, strong) NSIndexSet *indices;
+@property (nonatomic, assign) NSUInteger outstandingCount; // Indices still pending under this generation
+@end
+
+@implementation SmartCollectionViewRequestBatch
+@end
+
+@interface SmartCollectionViewRequestTracker ()
+
+@property (nonatomic, assign, readwrite) NSUInteger generation;
+@property (nonatomic, strong) NSMutableIndexSet *pending;
+@property (nonatomic, strong) NSMutableIndexSet *abandoned;
+@property (nonatomic, strong) NSMutableDictionary<NSNumber *, NSNumber *> *generationByIndex;
+@property (nonatomic, strong) NSMutableDictionary<NSNumber *, NSNumber *> *retryCounts;
+@property (nonatomic, strong) NSMutableArray<SmartCollectionViewRequestBatch *> *batches; // Oldest first
+
+@end
+
+@implementation SmartCollectionViewRequestTracker
+
+- (instancetype)init
+{
+    self = [super init];
+    if (self) {
+        _clock = ^NSTimeInterval{
+            return CACurrentMediaTime();
+        };
+        _timeout = 1.0;
+        _maxRetries = 3;
+        _generation = 0;
+        _pending = [NSMutableIndexSet indexSet];
+        _abandoned = [NSMutableIndexSet indexSet];
+        _generationByIndex = [NSMutableDictionary dictionary];
+        _retryCounts = [NSMutableDictionary dictionary];
+        _batches = [NSMutableArray array];
+    }
+    return self;
+}
+
+- (NSIndexSet *)pendingIndices
+{
+    return self.pending;
+}
+
+- (NSIndexSet *)abandonedIndices
+{
+    return self.abandoned;
+}
+
+- (NSUInteger)beginRequestForIndices:(NSIndexSet *)indices
+{
+    if (indices.count == 0) {
+        return self.generation;
+    }
+
+    self.generation += 1;
+    SmartCollectionViewRequestBatch *batch = [[SmartCollectionViewRequestBatch alloc] init];
+    batch.generation = self.generation;
+    batch.timestamp = self.clock();
+    batch.indices = [indices copy];
+    batch.outstandingCount = indices.count;
+
+    [self.pending addIndexes:indices];
+    NSNumber *generation = @(self.generation);
+    [indices enumerateIndexesUsingBlock:^(NSUInteger index, BOOL *stop) {
+        [self releaseIndex:index]; // Re-requested: the older batch no longer waits for it
+        self.generationByIndex[@(index)] = generation;
+    }];
+    [self.batches addObject:batch];
+    return self.generation;
+}
+
+- (NSTimeInterval)completeIndex:(NSInteger)index
+{
+    if (index < 0) {
+        return -1;
+    }
+    NSNumber *key = @(index);
+    NSTimeInterval latency = -1;
+    NSNumber *generation = self.generationByIndex[key];
+    if (generation && [self.pending containsIndex:index]) {
+        SmartCollectionViewRequestBatch *batch = [self batchForGeneration:generation.unsignedIntegerValue];
+        if (batch) {
+            latency = self.clock() - batch.timestamp;
+        }
+    }
+
+    [self releaseIndex:index];
+    [self.pending removeIndex:index];
+    [self.abandoned removeIndex:index];
+    [self.retryCounts removeObjectForKey:key];
+    return latency;
+}
+
+// Stops the index's batch from waiting for it; a batch with nothing left
+// to wait for is dropped, so it neither expires nor delays the next expiry
+- (void)releaseIndex:(NSUInteger)index
+{
+    NSNumber *key = @(index);
+    NSNumber *generation = self.generationByIndex[key];
+    if (!generation) {
+        return;
+    }
+    [self.generationByIndex removeObjectForKey:key];
+    NSUInteger position = [self positionOfBatchForGeneration:generation.unsignedIntegerValue];
+    if (position == NSNotFound) {
+        return;
+    }
+    SmartCollectionViewRequestBatch *batch = self.batches[position];
+    batch.outstandingCount -= 1;
+    if (batch.outstandingCount == 0) {
+        [self.batches removeObjectAtIndex:position];
+    }
+}
+
+- (SmartCollectionViewRequestBatch *)batchForGeneration:(NSUInteger)generation
+{
+    NSUInteger position = [self positionOfBatchForGeneration:generation];
+    return (position != NSNotFound) ? self.batches[position] : nil;
+}
+
+- (NSUInteger)positionOfBatchForGeneration:(NSUInteger)generation
+{
+    // Batches are appended in generation order
+    NSInteger low = 0;
+    NSInteger high = (NSInteger)self.batches.count - 1;
+    while (low <= high) {
+        NSInteger mid = low + (high - low) / 2;
+        NSUInteger midGeneration = self.batches[mid].generation;
+        if (midGeneration == generation) {
+            return (NSUInteger)mid;
+        }
+        if (midGeneration < generation) {
+            low = mid + 1;
+        } else {
+            high = mid - 1;
+        }
+    }
+    return NSNotFound;
+}
+
+- (NSIndexSet *)expireRequestsCollectingGenerations:(NSMutableIndexSet *)expiredGenerations
+{
+    NSMutableIndexSet *retryable = [NSMutableIndexSet indexSet];
+    NSTimeInterval now = self.clock();
+
+    while (self.batches.count > 0) {
+        SmartCollectionViewRequestBatch *batch = self.batches.firstObject;
+        if (now - batch.timestamp < self.timeout) {
+            break;
+        }
+        [batch.indices enumerateIndexesUsingBlock:^(NSUInteger index, BOOL *stop) {
+            NSNumber *key = @(index);
+            // Rendered, cancelled or re-requested by a newer batch since
+            if ([self.generationByIndex[key] unsignedIntegerValue] != batch.generation) {
+                return;
+            }
+            [self.pending removeIndex:index];
+            [self.generationByIndex removeObjectForKey:key];
+            [expiredGenerations addIndex:batch.generation];
+
+            NSInteger retries = [self.retryCounts[key] integerValue] + 1;
+            if (retries > self.maxRetries) {
+                [self.retryCounts removeObjectForKey:key];
+                [self.abandoned addIndex:index];
+            } else {
+                self.retryCounts[key] = @(retries);
+                [retryable addIndex:index];
+            }
+        }];
+        [self.batches removeObjectAtIndex:0];
+    }
+    return retryable;
+}
+
+- (NSIndexSet *)cancelRequestsOutsideIndexes:(NSIndexSet *)window
+{
+    NSMutableIndexSet *cancelled = [self.pending mutableCopy];
+    [cancelled removeIndexes:window];
+    if (cancelled.count > 0) {
+        [self.pending removeIndexes:cancelled];
+        [cancelled enumerateIndexesUsingBlock:^(NSUInteger index, BOOL *stop) {
+            [self releaseIndex:index];
+            [self.retryCounts removeObjectForKey:@(index)];
+        }];
+    }
+
+    // Abandoned indices get a fresh start once they scroll back in
+    NSMutableIndexSet *forgotten = [self.abandoned mutableCopy];
+    [forgotten removeIndexes:window];
+    [self.abandoned removeIndexes:forgotten];
+
+    return cancelled;
+}
+
+- (NSTimeInterval)timeUntilNextExpiry
+{
+    if (self.pending.count == 0 || self.batches.count == 0) {
+        return -1;
+    }
+    NSTimeInterval elapsed = self.clock() - self.batches.firstObject.timestamp;
+    return MAX(0, self.timeout - elapsed);
+}
+
+- (void)removeAll
+{
+    [self.pending removeAllIndexes];
+    [self.abandoned removeAllIndexes];
+    [self.generationByIndex removeAllObjects];
+    [self.retryCounts removeAllObjects];
+    [self.batches removeAllObjects];
+}
+
+@end
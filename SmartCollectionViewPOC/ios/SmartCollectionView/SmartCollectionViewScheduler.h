@@ -1,11 +1,21 @@
 #import <Foundation/Foundation.h>
 #import <CoreGraphics/CoreGraphics.h>
+#import "SmartCollectionViewLayoutProvider.h"
 
 @class SmartCollectionView;
 @class SmartCollectionViewLayoutCache;
 @class SmartCollectionViewVisibilityTracker;
 @class SmartCollectionViewMountController;
 @class SmartCollectionViewEventBus;
+@class SmartCollectionViewOffsetIndex;
+@class SmartCollectionViewWindowPolicy;
+@class SmartCollectionViewLandingPredictor;
+@class SmartCollectionViewRangeTracker;
+@class SmartCollectionViewRequestPrioritizer;
+@class SmartCollectionViewRequestTracker;
+@class SmartCollectionViewBatchController;
+@class SmartCollectionViewLatencyEstimator;
+@class SmartCollectionViewCreditController;
 
 NS_ASSUME_NONNULL_BEGIN
 
@@ -16,17 +26,40 @@ NS_ASSUME_NONNULL_BEGIN
 @property (nonatomic, strong, readonly) SmartCollectionViewVisibilityTracker *visibilityTracker;
 @property (nonatomic, strong, readonly) SmartCollectionViewMountController *mountController;
 @property (nonatomic, strong, readonly) SmartCollectionViewEventBus *eventBus;
+// Shared with the owner, which keeps it up to date as item sizes change
+@property (nonatomic, strong, nullable) SmartCollectionViewOffsetIndex *offsetIndex;
+@property (nonatomic, strong, readonly) SmartCollectionViewWindowPolicy *windowPolicy;
+@property (nonatomic, strong, readonly) SmartCollectionViewLandingPredictor *landingPredictor;
+// Set by the owner for grid layouts; visible ranges then come from its rect queries
+@property (nonatomic, strong, nullable) id<SmartCollectionViewLayoutProvider> layoutProvider;
+// Incremental visible-range lookup; nil until an offset index is attached
+@property (nonatomic, strong, readonly, nullable) SmartCollectionViewRangeTracker *rangeTracker;
+@property (nonatomic, strong, readonly) SmartCollectionViewRequestPrioritizer *requestPrioritizer;
+@property (nonatomic, strong, readonly) SmartCollectionViewRequestTracker *requestTracker;
+// Set by the owner in adaptive mode; request batches are then capped by predicted cost
+@property (nonatomic, strong, nullable) SmartCollectionViewBatchController *batchController;
+@property (nonatomic, strong, readonly) SmartCollectionViewLatencyEstimator *latencyEstimator;
+// Set by the owner when maxOutstandingRequests > 0; batches then wait for credits
+@property (nonatomic, strong, nullable) SmartCollectionViewCreditController *creditController;
 
 @property (nonatomic, assign) NSInteger initialNumToRender;
 @property (nonatomic, assign) NSInteger maxToRenderPerBatch;
 @property (nonatomic, assign) NSInteger overscanCount;
 @property (nonatomic, assign) CGFloat overscanLength;
 @property (nonatomic, assign) CGFloat shadowBufferMultiplier; // Multiplier for request range beyond mount range (default: 2.0)
+@property (nonatomic, assign) BOOL adaptiveShadowBuffer; // Size the leading shadow buffer from measured JS latency x velocity (default: NO)
 @property (nonatomic, assign, getter=isHorizontal) BOOL horizontal;
+@property (nonatomic, assign) BOOL predictiveWindowing; // Skew mount/request windows toward the scroll direction (default: NO)
+// Per-lane request caps within one batch; 0 = limited only by maxToRenderPerBatch
+@property (nonatomic, assign) NSInteger maxVisibleRequestsPerBatch;
+@property (nonatomic, assign) NSInteger maxMountBufferRequestsPerBatch;
+@property (nonatomic, assign) NSInteger maxShadowRequestsPerBatch;
 
 @property (nonatomic, assign) CGPoint scrollOffset;
 @property (nonatomic, assign) CGSize viewportSize;
 @property (nonatomic, assign) NSInteger totalItemCount;
+// Set by the owner to the current section's sticky header; requested first and never withdrawn (NSNotFound = none)
+@property (nonatomic, assign) NSInteger pinnedIndex;
 
 - (instancetype)initWithOwner:(SmartCollectionView *)owner
                   layoutCache:(SmartCollectionViewLayoutCache *)layoutCache
@@ -35,16 +68,29 @@ NS_ASSUME_NONNULL_BEGIN
                     eventBus:(SmartCollectionViewEventBus *)eventBus NS_DESIGNATED_INITIALIZER;
 - (instancetype)init NS_UNAVAILABLE;
 
-- (void)updateCumulativeOffsets:(NSArray<NSNumber *> *)offsets;
-- (void)updateRenderedIndices:(NSSet<NSNumber *> *)renderedIndices;
+// A child registered for index; completes its request
+- (void)noteItemRendered:(NSInteger)index;
+// JS stopped rendering the item at index; it may be requested again
+- (void)noteItemRemoved:(NSInteger)index;
+// JS has rendered every batch up to generation
+- (void)acknowledgeGeneration:(NSUInteger)generation;
 - (void)notifyLayoutRecomputed;
+- (void)notifyScrollEnded;
+// Called from scrollViewWillEndDragging with UIKit's projected resting offset
+- (void)noteProjectedTargetOffset:(CGPoint)targetOffset velocity:(CGPoint)velocity;
+- (void)clearProjectedTargetOffset;
 
 - (NSRange)visibleRange;
+- (NSRange)visibleRangeForOffset:(CGFloat)offset;
+// Mount window around the projected landing offset; empty when no fling is in flight
+- (NSRange)landingRange;
 - (NSRange)rangeToMount;
 - (NSRange)rangeToRequest; // Larger range for requesting items (shadow buffer)
 - (void)requestItemsIfNeeded;
-// Optional: allow owner to inform scheduler that certain indices were requested (to dedupe)
-- (void)noteItemsRequested:(NSArray<NSNumber *> *)indices;
+// YES if any window moved (or work was deferred) since the last call; records the current windows
+- (BOOL)windowsChangedSinceLastCheck;
+// Forces the next windowsChangedSinceLastCheck to return YES
+- (void)invalidateWindows;
 
 @end
 
@@ -1,10 +1,22 @@
 #import "SmartCollectionViewScheduler.h"
 #import "SmartCollectionView.h"
 #import "SmartCollectionViewLayoutCache.h"
-#import "SmartCollectionViewLayoutSpec.h"
 #import "SmartCollectionViewVisibilityTracker.h"
 #import "SmartCollectionViewMountController.h"
 #import "SmartCollectionViewEventBus.h"
+#import "SmartCollectionViewOffsetIndex.h"
+#import "SmartCollectionViewWindowPolicy.h"
+#import "SmartCollectionViewLandingPredictor.h"
+#import "SmartCollectionViewRangeTracker.h"
+#import "SmartCollectionViewRequestPrioritizer.h"
+#import "SmartCollectionViewRequestTracker.h"
+#import "SmartCollectionViewBatchController.h"
+#import "SmartCollectionViewLatencyEstimator.h"
+#import "SmartCollectionViewCreditController.h"
+#import <QuartzCore/QuartzCore.h>
+
+// Upper bound on the adaptive leading shadow buffer, however slow JS gets
+static const NSInteger kMaxAdaptiveShadowItems = 200;
 
 @interface SmartCollectionViewScheduler ()
 
@@ -13,17 +25,30 @@
 @property (nonatomic, strong, readwrite) SmartCollectionViewVisibilityTracker *visibilityTracker;
 @property (nonatomic, strong, readwrite) SmartCollectionViewMountController *mountController;
 @property (nonatomic, strong, readwrite) SmartCollectionViewEventBus *eventBus;
-
-@property (nonatomic, copy) NSArray<NSNumber *> *cumulativeOffsets;
-@property (nonatomic, strong) NSSet<NSNumber *> *renderedIndices;
-@property (nonatomic, strong) NSMutableSet<NSNumber *> *pendingRequestedIndices;
+@property (nonatomic, strong, readwrite) SmartCollectionViewWindowPolicy *windowPolicy;
+@property (nonatomic, strong, readwrite) SmartCollectionViewLandingPredictor *landingPredictor;
+@property (nonatomic, strong, readwrite, nullable) SmartCollectionViewRangeTracker *rangeTracker;
+@property (nonatomic, strong, readwrite) SmartCollectionViewRequestPrioritizer *requestPrioritizer;
+@property (nonatomic, strong, readwrite) SmartCollectionViewRequestTracker *requestTracker;
+@property (nonatomic, strong, readwrite) SmartCollectionViewLatencyEstimator *latencyEstimator;
+
+@property (nonatomic, strong) NSMutableIndexSet *renderedIndices;
+
+// Windows seen by the last windowsChangedSinceLastCheck
+@property (nonatomic, assign) NSRange lastVisibleRange;
+@property (nonatomic, assign) NSRange lastMountRange;
+@property (nonatomic, assign) NSRange lastRequestRange;
+@property (nonatomic, assign) NSRange lastLandingRange;
+@property (nonatomic, assign) BOOL windowsDirty;
+@property (nonatomic, assign) BOOL hasDeferredRequests;
+@property (nonatomic, assign) BOOL expiryCheckScheduled;
+@property (nonatomic, assign) BOOL creditRetryScheduled;
 
 @end
 
 @interface SmartCollectionView (SchedulerAccess)
 - (NSInteger)itemCount;
 - (CGSize)sizeForItemAtIndex:(NSInteger)index;
-- (BOOL)hasRenderedItemAtIndex:(NSInteger)index;
 @end
 
 @implementation SmartCollectionViewScheduler
@@ -47,44 +72,208 @@
         _visibilityTracker = visibilityTracker;
         _mountController = mountController;
         _eventBus = eventBus;
-        _cumulativeOffsets = @[];
-        _renderedIndices = [NSSet set];
-        _pendingRequestedIndices = [NSMutableSet set];
+        _windowPolicy = [[SmartCollectionViewWindowPolicy alloc] init];
+        _landingPredictor = [[SmartCollectionViewLandingPredictor alloc] init];
+        _requestPrioritizer = [[SmartCollectionViewRequestPrioritizer alloc] init];
+        _renderedIndices = [NSMutableIndexSet indexSet];
+        _requestTracker = [[SmartCollectionViewRequestTracker alloc] init];
+        _latencyEstimator = [[SmartCollectionViewLatencyEstimator alloc] init];
         _initialNumToRender = 10;
         _maxToRenderPerBatch = 10;
         _overscanCount = 5;
         _overscanLength = 0;
         _shadowBufferMultiplier = 2.0; // Default: request 2x the mount range
+        _adaptiveShadowBuffer = NO;
         _horizontal = YES;
+        _predictiveWindowing = NO;
+        _maxVisibleRequestsPerBatch = 0;
+        _maxMountBufferRequestsPerBatch = 0;
+        _maxShadowRequestsPerBatch = 0;
         _scrollOffset = CGPointZero;
         _viewportSize = CGSizeZero;
         _totalItemCount = 0;
+        _pinnedIndex = NSNotFound;
+        _windowsDirty = YES;
+        _hasDeferredRequests = NO;
     }
     return self;
 }
 
-- (void)updateCumulativeOffsets:(NSArray<NSNumber *> *)offsets
+- (void)setOffsetIndex:(SmartCollectionViewOffsetIndex *)offsetIndex
 {
-    self.cumulativeOffsets = offsets ?: @[];
+    _offsetIndex = offsetIndex;
+    self.rangeTracker = offsetIndex ? [[SmartCollectionViewRangeTracker alloc] initWithOffsetIndex:offsetIndex] : nil;
+    self.windowsDirty = YES;
 }
 
-- (void)updateRenderedIndices:(NSSet<NSNumber *> *)renderedIndices
+- (void)setLayoutProvider:(id<SmartCollectionViewLayoutProvider>)layoutProvider
 {
-    self.renderedIndices = renderedIndices ?: [NSSet set];
-    // Clear from pending any indices that are now rendered
-    if (renderedIndices.count > 0) {
-        for (NSNumber *idx in renderedIndices) {
-            [self.pendingRequestedIndices removeObject:idx];
-        }
+    _layoutProvider = layoutProvider;
+    [self.rangeTracker invalidate];
+    self.windowsDirty = YES;
+}
+
+- (void)setScrollOffset:(CGPoint)scrollOffset
+{
+    _scrollOffset = scrollOffset;
+    CGFloat axisOffset = self.isHorizontal ? scrollOffset.x : scrollOffset.y;
+    [self.windowPolicy recordOffset:axisOffset atTime:CACurrentMediaTime()];
+    [self.landingPredictor updateWithCurrentOffset:axisOffset];
+}
+
+- (void)setHorizontal:(BOOL)horizontal
+{
+    if (_horizontal != horizontal) {
+        [self.windowPolicy reset];
+        [self.landingPredictor reset];
+        [self.rangeTracker invalidate];
+        self.windowsDirty = YES;
+    }
+    _horizontal = horizontal;
+}
+
+- (void)setPinnedIndex:(NSInteger)pinnedIndex
+{
+    if (_pinnedIndex != pinnedIndex) {
+        self.windowsDirty = YES;
+    }
+    _pinnedIndex = pinnedIndex;
+}
+
+- (void)setPredictiveWindowing:(BOOL)predictiveWindowing
+{
+    _predictiveWindowing = predictiveWindowing;
+    self.windowPolicy.predictive = predictiveWindowing;
+}
+
+- (void)setMaxVisibleRequestsPerBatch:(NSInteger)maxVisibleRequestsPerBatch
+{
+    _maxVisibleRequestsPerBatch = maxVisibleRequestsPerBatch;
+    self.requestPrioritizer.visibleLaneCap = maxVisibleRequestsPerBatch;
+}
+
+- (void)setMaxMountBufferRequestsPerBatch:(NSInteger)maxMountBufferRequestsPerBatch
+{
+    _maxMountBufferRequestsPerBatch = maxMountBufferRequestsPerBatch;
+    self.requestPrioritizer.mountBufferLaneCap = maxMountBufferRequestsPerBatch;
+}
+
+- (void)setMaxShadowRequestsPerBatch:(NSInteger)maxShadowRequestsPerBatch
+{
+    _maxShadowRequestsPerBatch = maxShadowRequestsPerBatch;
+    self.requestPrioritizer.shadowLaneCap = maxShadowRequestsPerBatch;
+}
+
+- (void)noteItemRendered:(NSInteger)index
+{
+    if (index < 0) {
+        return;
+    }
+    [self.renderedIndices addIndex:index];
+    NSTimeInterval latency = [self.requestTracker completeIndex:index];
+    if (latency >= 0) {
+        [self.latencyEstimator recordLatency:latency];
+        [self returnCredits:1];
+    }
+}
+
+- (void)noteItemRemoved:(NSInteger)index
+{
+    if (index < 0) {
+        return;
     }
+    [self.renderedIndices removeIndex:index];
+    self.windowsDirty = YES; // Still in the window: request it again on the next tick
+}
+
+- (void)acknowledgeGeneration:(NSUInteger)generation
+{
+    SmartCollectionViewCreditController *creditController = self.creditController;
+    if (!creditController || generation <= creditController.acknowledgedGeneration) {
+        return;
+    }
+    [creditController acknowledgeGeneration:generation];
+    [self scheduleCreditRetry];
+}
+
+- (void)returnCredits:(NSUInteger)count
+{
+    SmartCollectionViewCreditController *creditController = self.creditController;
+    if (!creditController || count == 0) {
+        return;
+    }
+    [creditController returnCredits:count];
+    [self scheduleCreditRetry];
+}
+
+- (void)scheduleCreditRetry
+{
+    // Requests held back for credits go out once credits return, even if nothing scrolls
+    if (!self.hasDeferredRequests || self.creditRetryScheduled) {
+        return;
+    }
+    self.creditRetryScheduled = YES;
+    __weak typeof(self) weakSelf = self;
+    dispatch_async(dispatch_get_main_queue(), ^{
+        weakSelf.creditRetryScheduled = NO;
+        [weakSelf requestItemsIfNeeded];
+    });
 }
 
 - (void)notifyLayoutRecomputed
 {
-    // Placeholder for future scheduler logic (eviction, diffing, etc.)
+    // Frames may have moved under unchanged ranges; let the next scroll tick do full work
+    self.windowsDirty = YES;
+}
+
+- (void)notifyScrollEnded
+{
+    // Resting windows go back to symmetric padding
+    [self.windowPolicy reset];
+    [self.landingPredictor reset];
+}
+
+- (void)noteProjectedTargetOffset:(CGPoint)targetOffset velocity:(CGPoint)velocity
+{
+    BOOL horizontal = self.isHorizontal;
+    CGFloat viewportLength = horizontal ? self.viewportSize.width : self.viewportSize.height;
+    CGFloat contentLength = [self.offsetIndex totalLength];
+    if (self.layoutProvider) {
+        CGSize contentSize = self.layoutProvider.contentSize;
+        contentLength = horizontal ? contentSize.width : contentSize.height;
+    } else if (self.offsetIndex.count != [self.owner itemCount]) {
+        // Without a current index, let the predictor skip clamping against the end
+        contentLength = CGFLOAT_MAX;
+    }
+    // UIKit reports fling velocity in points per millisecond
+    CGFloat axisVelocity = (horizontal ? velocity.x : velocity.y) * 1000.0;
+    [self.landingPredictor beginDecelerationFromOffset:(horizontal ? self.scrollOffset.x : self.scrollOffset.y)
+                                        toTargetOffset:(horizontal ? targetOffset.x : targetOffset.y)
+                                              velocity:axisVelocity
+                                        viewportLength:viewportLength
+                                         contentLength:contentLength];
+}
+
+- (void)clearProjectedTargetOffset
+{
+    [self.landingPredictor reset];
 }
 
 - (NSRange)visibleRange
+{
+    CGFloat offset = self.isHorizontal ? self.scrollOffset.x : self.scrollOffset.y;
+    CGFloat viewportLength = self.isHorizontal ? self.viewportSize.width : self.viewportSize.height;
+    NSInteger itemCount = [self.owner itemCount];
+
+    // Gallop from the previous range when the tracker's index is current
+    SmartCollectionViewRangeTracker *tracker = self.rangeTracker;
+    if (tracker && !self.layoutProvider && itemCount > 0 && viewportLength > 0 && self.offsetIndex.count == itemCount) {
+        return [tracker rangeForStartOffset:offset endOffset:offset + viewportLength changed:NULL];
+    }
+    return [self visibleRangeForOffset:offset];
+}
+
+- (NSRange)visibleRangeForOffset:(CGFloat)offset
 {
     NSInteger itemCount = [self.owner itemCount];
     if (itemCount <= 0) {
@@ -99,89 +288,46 @@
         return NSMakeRange(0, length);
     }
 
-    CGFloat startOffset = horizontal ? self.scrollOffset.x : self.scrollOffset.y;
+    CGFloat startOffset = offset;
     CGFloat endOffset = startOffset + viewportLength;
 
     NSInteger startIndex = 0;
     NSInteger endIndex = itemCount;
 
-    // Binary search for start index using cumulative offsets if available
-    if (self.cumulativeOffsets.count == itemCount) {
-        NSInteger left = 0;
-        NSInteger right = itemCount - 1;
-        while (left <= right) {
-            NSInteger mid = (left + right) / 2;
-            CGFloat offset = [self.cumulativeOffsets[mid] doubleValue];
-            if (offset < startOffset) {
-                left = mid + 1;
-            } else {
-                right = mid - 1;
-            }
-        }
-        startIndex = MAX(0, MIN(left, itemCount - 1));
-
-        // Search for end index (first item whose start >= endOffset)
-        left = startIndex;
-        right = itemCount - 1;
-        while (left <= right) {
-            NSInteger mid = (left + right) / 2;
-            CGFloat offset = [self.cumulativeOffsets[mid] doubleValue];
-            if (offset < endOffset) {
-                left = mid + 1;
-            } else {
-                right = mid - 1;
-            }
-        }
-        endIndex = MAX(startIndex, MIN(left, itemCount));
-
-        // Ensure items actually intersect viewport
-        if (endIndex > startIndex) {
-            NSInteger intersectLeft = startIndex;
-            NSInteger intersectRight = endIndex - 1;
-            NSInteger lastIntersectingIndex = startIndex - 1;
-            while (intersectLeft <= intersectRight) {
-                NSInteger mid = (intersectLeft + intersectRight) / 2;
-                CGFloat itemStart = [self.cumulativeOffsets[mid] doubleValue];
-                CGSize itemSize = [self.owner sizeForItemAtIndex:mid];
-                CGFloat itemEnd = itemStart + (horizontal ? itemSize.width : itemSize.height);
-                if (itemEnd > startOffset) {
-                    lastIntersectingIndex = mid;
-                    intersectLeft = mid + 1;
-                } else {
-                    intersectRight = mid - 1;
-                }
-            }
-            if (lastIntersectingIndex >= startIndex) {
-                endIndex = lastIntersectingIndex + 1;
-            } else {
-                endIndex = startIndex;
-            }
+    // O(log n) lookups on the offset index
+    SmartCollectionViewOffsetIndex *offsetIndex = self.offsetIndex;
+    id<SmartCollectionViewLayoutProvider> layoutProvider = self.layoutProvider;
+    if (layoutProvider && layoutProvider.itemCount == itemCount) {
+        // Grid: every item in the viewport rect; provider queries are O(log n + k)
+        CGFloat crossLength = horizontal ? self.viewportSize.height : self.viewportSize.width;
+        CGRect viewportRect = horizontal ? CGRectMake(startOffset, 0, viewportLength, MAX(crossLength, layoutProvider.contentSize.height))
+                                         : CGRectMake(0, startOffset, MAX(crossLength, layoutProvider.contentSize.width), viewportLength);
+        __block NSInteger firstCandidate = itemCount;
+        __block NSInteger lastCandidate = -1;
+        [layoutProvider enumerateItemsInRect:viewportRect usingBlock:^(NSInteger index, CGRect frame, BOOL *stop) {
+            firstCandidate = MIN(firstCandidate, index);
+            lastCandidate = MAX(lastCandidate, index);
+        }];
+        startIndex = (lastCandidate >= 0) ? firstCandidate : 0;
+        endIndex = lastCandidate + 1;
+    } else if (offsetIndex.count > 0) {
+        // Between a count change and the next layout pass the index trails the
+        // item count; the prefix it covers still places the viewport
+        NSInteger indexedCount = MIN(offsetIndex.count, itemCount);
+
+        // First item whose end lies past the leading edge
+        startIndex = MIN([offsetIndex indexForOffset:startOffset], indexedCount - 1);
+
+        // First item whose end lies past the trailing edge; it is still visible if it starts before that edge
+        endIndex = [offsetIndex indexForOffset:endOffset];
+        if (endIndex < indexedCount && [offsetIndex offsetAtIndex:endIndex] < endOffset) {
+            endIndex += 1;
         }
+        endIndex = MAX(startIndex, MIN(endIndex, indexedCount));
     } else {
-        // Fallback: linear scan using layout cache if cumulative offsets are not available
-        NSInteger firstCandidate = 0;
-        NSInteger lastCandidate = itemCount - 1;
-        for (NSInteger i = 0; i < itemCount; i++) {
-            SmartCollectionViewLayoutSpec *spec = [self.layoutCache specForIndex:i];
-            CGRect frame = spec ? spec.frame : CGRectZero;
-            CGFloat itemStart = horizontal ? CGRectGetMinX(frame) : CGRectGetMinY(frame);
-            CGFloat itemEnd = horizontal ? CGRectGetMaxX(frame) : CGRectGetMaxY(frame);
-            if (itemEnd > startOffset) {
-                firstCandidate = i;
-                break;
-            }
-        }
-        for (NSInteger i = firstCandidate; i < itemCount; i++) {
-            SmartCollectionViewLayoutSpec *spec = [self.layoutCache specForIndex:i];
-            CGRect frame = spec ? spec.frame : CGRectZero;
-            CGFloat itemStart = horizontal ? CGRectGetMinX(frame) : CGRectGetMinY(frame);
-            if (itemStart >= endOffset) {
-                lastCandidate = MAX(firstCandidate, i - 1);
-                break;
-            }
-        }
-        startIndex = firstCandidate;
-        endIndex = MIN(itemCount, lastCandidate + 1);
+        // Nothing laid out yet: the same initial window as before bounds are known
+        startIndex = 0;
+        endIndex = MIN(5, itemCount);
     }
 
     if (startIndex >= endIndex) {
@@ -192,14 +338,8 @@
     return NSMakeRange(startIndex, endIndex - startIndex);
 }
 
-- (NSRange)rangeToMount
+- (NSInteger)mountBufferCount
 {
-    NSRange visibleRange = [self visibleRange];
-    NSInteger itemCount = [self.owner itemCount];
-    if (visibleRange.length == 0 || itemCount == 0) {
-        return NSMakeRange(0, 0);
-    }
-
     NSInteger bufferCount = self.overscanCount;
     if (self.overscanLength > 0) {
         CGFloat viewportLength = self.isHorizontal ? self.viewportSize.width : self.viewportSize.height;
@@ -209,9 +349,20 @@
             bufferCount = MAX(bufferCount, MIN(computed, 100));
         }
     }
+    return bufferCount;
+}
+
+- (NSRange)rangeToMount
+{
+    NSRange visibleRange = [self visibleRange];
+    NSInteger itemCount = [self.owner itemCount];
+    if (visibleRange.length == 0 || itemCount == 0) {
+        return NSMakeRange(0, 0);
+    }
 
-    NSInteger start = (NSInteger)visibleRange.location - bufferCount;
-    NSInteger end = NSMaxRange(visibleRange) + bufferCount;
+    SmartCollectionViewWindowPadding padding = [self.windowPolicy paddingForBuffer:[self mountBufferCount]];
+    NSInteger start = (NSInteger)visibleRange.location - padding.before;
+    NSInteger end = NSMaxRange(visibleRange) + padding.after;
     start = MAX(0, start);
     end = MIN(itemCount, end);
 
@@ -223,6 +374,54 @@
     return NSMakeRange(start, end - start);
 }
 
+- (SmartCollectionViewWindowPadding)adaptiveShadowPaddingWithIdleBuffer:(NSInteger)idleBuffer
+{
+    // Far enough ahead that items requested now arrive before they reach the mount range;
+    // half the static buffer stays on both sides so a reversal is not starved
+    NSInteger floorItems = MAX(1, idleBuffer / 2);
+    CGFloat velocity = self.windowPolicy.velocity;
+    NSInteger lead = [self.latencyEstimator leadItemsForVelocity:velocity averageItemLength:[self averageItemLength]];
+    NSInteger ahead = MIN(MAX(floorItems, lead), kMaxAdaptiveShadowItems);
+
+    SmartCollectionViewWindowPadding padding = { floorItems, floorItems };
+    if (velocity > 0) {
+        padding.after = ahead;
+    } else if (velocity < 0) {
+        padding.before = ahead;
+    }
+    return padding;
+}
+
+- (CGFloat)averageItemLength
+{
+    SmartCollectionViewOffsetIndex *offsetIndex = self.offsetIndex;
+    if (offsetIndex.count > 0 && offsetIndex.totalLength > 0) {
+        return offsetIndex.totalLength / (CGFloat)offsetIndex.count;
+    }
+    return self.isHorizontal ? self.owner.estimatedItemSize.width : self.owner.estimatedItemSize.height;
+}
+
+- (NSRange)landingRange
+{
+    if (!self.landingPredictor.hasTarget) {
+        return NSMakeRange(0, 0);
+    }
+    NSRange landingVisible = [self visibleRangeForOffset:self.landingPredictor.targetOffset];
+    NSInteger itemCount = [self.owner itemCount];
+    if (landingVisible.length == 0 || itemCount == 0) {
+        return NSMakeRange(0, 0);
+    }
+
+    // The list comes to rest there, so pad symmetrically rather than by velocity
+    NSInteger bufferCount = [self mountBufferCount];
+    NSInteger start = MAX(0, (NSInteger)landingVisible.location - bufferCount);
+    NSInteger end = MIN(itemCount, (NSInteger)NSMaxRange(landingVisible) + bufferCount);
+    if (start > end) {
+        return landingVisible;
+    }
+    return NSMakeRange(start, end - start);
+}
+
 - (NSRange)rangeToRequest
 {
     // Request range is larger than mount range (shadow buffer)
@@ -236,8 +435,12 @@
     
     // Calculate buffer extension based on multiplier
     NSInteger bufferExtension = (NSInteger)(mountRange.length * (self.shadowBufferMultiplier - 1.0));
-    NSInteger start = MAX(0, (NSInteger)mountRange.location - bufferExtension);
-    NSInteger end = MIN(itemCount, NSMaxRange(mountRange) + bufferExtension);
+    SmartCollectionViewWindowPadding padding = [self.windowPolicy paddingForBuffer:bufferExtension];
+    if (self.adaptiveShadowBuffer && self.latencyEstimator.hasSamples) {
+        padding = [self adaptiveShadowPaddingWithIdleBuffer:bufferExtension];
+    }
+    NSInteger start = MAX(0, (NSInteger)mountRange.location - padding.before);
+    NSInteger end = MIN(itemCount, NSMaxRange(mountRange) + padding.after);
     
     if (start > end) {
         start = mountRange.location;
@@ -258,39 +461,179 @@
         return;
     }
 
-    // Use rangeToRequest (larger shadow buffer) instead of rangeToMount
-    NSRange requestRange = [self rangeToRequest];
-    NSMutableArray<NSNumber *> *needed = [NSMutableArray array];
-    NSInteger upperBound = MIN(self.totalItemCount, NSMaxRange(requestRange));
-    for (NSInteger index = requestRange.location; index < upperBound; index++) {
-        NSNumber *num = @(index);
-        BOOL notRendered = ![self.renderedIndices containsObject:num] && ![self.owner hasRenderedItemAtIndex:index];
-        BOOL notPending = ![self.pendingRequestedIndices containsObject:num];
-        if (notRendered && notPending) {
-            [needed addObject:@(index)];
+    // Use rangeToRequest (larger shadow buffer) instead of rangeToMount.
+    // During a long fling, only what is on screen now plus the landing window is
+    // requested; the ranges in between would be scrolled past before they mount.
+    // The rendered set then has gaps, which is safe: each child carries its data
+    // index, so the landing items register at their own indices.
+    NSRange landingRange = [self landingRange];
+    BOOL skipIntermediate = self.landingPredictor.shouldSkipIntermediateRanges && landingRange.length > 0;
+    NSRange mountRange = skipIntermediate ? visibleRange : [self rangeToMount];
+    NSRange requestRange = skipIntermediate ? visibleRange : [self rangeToRequest];
+
+    // Lost requests become eligible again; requests the window has moved away from are withdrawn
+    SmartCollectionViewRequestTracker *requestTracker = self.requestTracker;
+    SmartCollectionViewCreditController *creditController = self.creditController;
+    NSUInteger pendingBefore = requestTracker.pendingIndices.count;
+    NSMutableIndexSet *expiredGenerations = [NSMutableIndexSet indexSet];
+    [requestTracker expireRequestsCollectingGenerations:expiredGenerations];
+    NSMutableIndexSet *window = [NSMutableIndexSet indexSetWithIndexesInRange:requestRange];
+    [window addIndexesInRange:visibleRange];
+    [window addIndexesInRange:landingRange];
+    // The pinned header stays on screen however far its section scrolls
+    NSRange pinnedRange = (self.pinnedIndex != NSNotFound) ? NSMakeRange(self.pinnedIndex, 1) : NSMakeRange(0, 0);
+    [window addIndexesInRange:pinnedRange];
+    NSIndexSet *cancelled = [requestTracker cancelRequestsOutsideIndexes:window];
+    if (cancelled.count > 0) {
+        [self.eventBus emitCancelRequests:cancelled generation:requestTracker.generation];
+    }
+    if (creditController) {
+        [creditController returnCredits:pendingBefore - requestTracker.pendingIndices.count];
+        // An expired batch will not be acknowledged any more; stop waiting for it.
+        // Batches JS answered keep counting until its acknowledgedGeneration arrives
+        [creditController forgetGenerations:expiredGenerations];
+    }
+    [self scheduleExpiryCheck];
+
+    // Request range minus rendered minus pending; index sets subtract run by run
+    NSMutableIndexSet *current = [self unrequestedIndexesInRange:requestRange];
+    NSMutableIndexSet *landing = [self unrequestedIndexesInRange:landingRange];
+    [landing removeIndexes:current];
+    NSMutableIndexSet *pinned = [self unrequestedIndexesInRange:pinnedRange];
+    [current removeIndexes:pinned];
+    [landing removeIndexes:pinned];
+
+    NSUInteger total = pinned.count + current.count + landing.count;
+    if (total == 0) {
+        self.hasDeferredRequests = NO;
+        return;
+    }
+
+    NSUInteger cap = (self.maxToRenderPerBatch > 0) ? (NSUInteger)self.maxToRenderPerBatch : total;
+    SmartCollectionViewBatchController *batchController = self.batchController;
+    if (batchController.hasSamples) {
+        // Predicted cost decides the batch; the count only bounds it from above
+        cap = (NSUInteger)MAX(1, batchController.maxBatchSize);
+    }
+    if (creditController) {
+        // Out of credits: hold everything back until JS catches up
+        cap = MIN(cap, [creditController availableCredits]);
+        if (cap == 0) {
+            self.hasDeferredRequests = YES;
+            return;
+        }
+    }
+
+    // Visible, then mount buffer, then shadow buffer, nearest the scroll's leading edge first
+    CGFloat velocity = self.windowPolicy.velocity;
+    NSInteger direction = (velocity > 0) ? 1 : ((velocity < 0) ? -1 : 0);
+    NSMutableArray<NSNumber *> *needed = [[self.requestPrioritizer orderedRequestsForCandidates:current
+                                                                                  visibleRange:visibleRange
+                                                                                    mountRange:mountRange
+                                                                                  requestRange:requestRange
+                                                                                     direction:direction
+                                                                                         limit:cap] mutableCopy];
+    // The pinned header goes ahead of the visible lane; it is already on screen
+    [pinned enumerateIndexesUsingBlock:^(NSUInteger index, BOOL *stop) {
+        [needed insertObject:@(index) atIndex:0];
+    }];
+    if (needed.count > cap) {
+        [needed removeObjectsInRange:NSMakeRange(cap, needed.count - cap)];
+    }
+    [landing enumerateIndexesUsingBlock:^(NSUInteger index, BOOL *stop) {
+        if (needed.count >= cap) {
+            *stop = YES;
+            return;
+        }
+        [needed addObject:@(index)];
+    }];
+
+    if (batchController.hasSamples && needed.count > 0) {
+        SmartCollectionView *owner = self.owner;
+        NSInteger fitting = [batchController batchSizeForCount:needed.count
+                                            itemTypeAtPosition:^NSString *(NSInteger position) {
+            return [owner itemTypeAtIndex:[needed[position] integerValue]];
+        }
+                                                      fallback:needed.count];
+        if (fitting < (NSInteger)needed.count) {
+            [needed removeObjectsInRange:NSMakeRange(fitting, needed.count - fitting)];
         }
     }
 
+    // Leftovers (over the batch or a lane cap) go out on the next tick, even if the windows have not moved by then
+    self.hasDeferredRequests = (needed.count < total);
     if (needed.count == 0) {
         return;
     }
 
-    if (self.maxToRenderPerBatch > 0 && needed.count > self.maxToRenderPerBatch) {
-        needed = [[needed subarrayWithRange:NSMakeRange(0, self.maxToRenderPerBatch)] mutableCopy];
+    // Mark as pending under a new generation
+    NSMutableIndexSet *batch = [NSMutableIndexSet indexSet];
+    for (NSNumber *n in needed) {
+        [batch addIndex:[n unsignedIntegerValue]];
     }
+    NSUInteger generation = [requestTracker beginRequestForIndices:batch];
+    [creditController issueCredits:batch.count forGeneration:generation];
+    [self.eventBus emitRequestItems:needed generation:generation];
+    [self scheduleExpiryCheck];
+}
 
-    [self.eventBus emitRequestItems:needed];
-    // Mark as pending
-    for (NSNumber *n in needed) {
-        [self.pendingRequestedIndices addObject:n];
+- (void)scheduleExpiryCheck
+{
+    if (self.expiryCheckScheduled) {
+        return;
     }
+    NSTimeInterval delay = [self.requestTracker timeUntilNextExpiry];
+    if (delay < 0) {
+        return;
+    }
+
+    // Retry lost requests even if the user stops scrolling
+    self.expiryCheckScheduled = YES;
+    __weak typeof(self) weakSelf = self;
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(delay * NSEC_PER_SEC)), dispatch_get_main_queue(), ^{
+        weakSelf.expiryCheckScheduled = NO;
+        [weakSelf requestItemsIfNeeded];
+    });
+}
+
+- (BOOL)windowsChangedSinceLastCheck
+{
+    NSRange visibleRange = [self visibleRange];
+    NSRange mountRange = [self rangeToMount];
+    NSRange requestRange = [self rangeToRequest];
+    NSRange landingRange = [self landingRange];
+
+    BOOL changed = self.windowsDirty || self.hasDeferredRequests ||
+                   !NSEqualRanges(visibleRange, self.lastVisibleRange) ||
+                   !NSEqualRanges(mountRange, self.lastMountRange) ||
+                   !NSEqualRanges(requestRange, self.lastRequestRange) ||
+                   !NSEqualRanges(landingRange, self.lastLandingRange);
+
+    self.lastVisibleRange = visibleRange;
+    self.lastMountRange = mountRange;
+    self.lastRequestRange = requestRange;
+    self.lastLandingRange = landingRange;
+    self.windowsDirty = NO;
+    return changed;
+}
+
+- (void)invalidateWindows
+{
+    self.windowsDirty = YES;
 }
 
-- (void)noteItemsRequested:(NSArray<NSNumber *> *)indices
+- (NSMutableIndexSet *)unrequestedIndexesInRange:(NSRange)range
 {
-    for (NSNumber *n in indices) {
-        [self.pendingRequestedIndices addObject:n];
+    NSMutableIndexSet *indexes = [NSMutableIndexSet indexSet];
+    NSInteger upperBound = MIN(self.totalItemCount, (NSInteger)NSMaxRange(range));
+    if (range.length == 0 || (NSInteger)range.location >= upperBound) {
+        return indexes;
     }
+    [indexes addIndexesInRange:NSMakeRange(range.location, upperBound - range.location)];
+    [indexes removeIndexes:self.renderedIndices];
+    [indexes removeIndexes:self.requestTracker.pendingIndices];
+    [indexes removeIndexes:self.requestTracker.abandonedIndices];
+    return indexes;
 }
 
 @end
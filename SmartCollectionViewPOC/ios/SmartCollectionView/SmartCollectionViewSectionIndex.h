@@ -0,0 +1,40 @@
+#import <Foundation/Foundation.h>
+#import <CoreGraphics/CoreGraphics.h>
+
+@class SmartCollectionViewOffsetIndex;
+
+NS_ASSUME_NONNULL_BEGIN
+
+// Sections of the flat item list, each starting at a header item.
+// Section lengths along the scroll axis live in their own offset index,
+// derived from the item offset index, so offset->section is O(log s)
+// and a sticky header's position for a scroll offset is O(log s).
+// Items before the first header belong to no section.
+@interface SmartCollectionViewSectionIndex : NSObject
+
+@property (nonatomic, assign, readonly) NSInteger sectionCount;
+@property (nonatomic, copy) NSIndexSet *headerIndices;
+
+// Refreshes section lengths from item offsets in O(s log n).
+// O(1) when neither the item offsets nor the headers changed since the last call.
+- (void)updateWithItemOffsets:(SmartCollectionViewOffsetIndex *)itemOffsets;
+- (void)removeAll;
+
+// Section containing offset, or NSNotFound before the first header
+- (NSInteger)sectionForOffset:(CGFloat)offset;
+// Section containing the item, or NSNotFound before the first header
+- (NSInteger)sectionForItemAtIndex:(NSInteger)index;
+- (NSInteger)headerIndexForSection:(NSInteger)section;
+- (CGFloat)startOffsetOfSection:(NSInteger)section;
+- (CGFloat)endOffsetOfSection:(NSInteger)section;
+
+// Where the section's header is drawn along the scroll axis: at the leading
+// edge of the viewport while its section is scrolling past, pushed back by
+// the end of the section, and never before its own position
+- (CGFloat)pinnedOffsetForSection:(NSInteger)section
+                     scrollOffset:(CGFloat)scrollOffset
+                     headerLength:(CGFloat)headerLength;
+
+@end
+
+NS_ASSUME_NONNULL_END
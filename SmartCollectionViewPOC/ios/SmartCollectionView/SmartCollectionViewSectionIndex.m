@@ -0,0 +1,144 @@
+#import "SmartCollectionViewSectionIndex.h"
+#import "SmartCollectionViewOffsetIndex.h"
+#import <stdlib.h>
+
+@implementation SmartCollectionViewSectionIndex
+{
+    NSInteger *_headers;   // header item index per section, ascending
+    NSInteger _headerCapacity;
+    SmartCollectionViewOffsetIndex *_sections; // section lengths
+    CGFloat _leadingOffset; // offset of the first header
+    NSUInteger _itemMutationCount; // itemOffsets.mutationCount at the last update
+    BOOL _needsUpdate;
+}
+
+- (instancetype)init
+{
+    self = [super init];
+    if (self) {
+        _headerIndices = [NSIndexSet indexSet];
+        _headers = NULL;
+        _headerCapacity = 0;
+        _sectionCount = 0;
+        _sections = [[SmartCollectionViewOffsetIndex alloc] init];
+        _leadingOffset = 0;
+        _itemMutationCount = 0;
+        _needsUpdate = YES;
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    free(_headers);
+}
+
+- (void)setHeaderIndices:(NSIndexSet *)headerIndices
+{
+    _headerIndices = [headerIndices copy] ?: [NSIndexSet indexSet];
+    _needsUpdate = YES;
+}
+
+- (void)removeAll
+{
+    self.headerIndices = [NSIndexSet indexSet];
+    _sectionCount = 0;
+    [_sections removeAll];
+}
+
+- (void)updateWithItemOffsets:(SmartCollectionViewOffsetIndex *)itemOffsets
+{
+    if (!_needsUpdate && itemOffsets.mutationCount == _itemMutationCount) {
+        return;
+    }
+    _needsUpdate = NO;
+    _itemMutationCount = itemOffsets.mutationCount;
+
+    // Headers past the laid-out items have no position yet
+    NSInteger itemCount = itemOffsets.count;
+    NSInteger headerCount = (NSInteger)[_headerIndices countOfIndexesInRange:NSMakeRange(0, (NSUInteger)MAX(0, itemCount))];
+    if (headerCount > _headerCapacity) {
+        _headerCapacity = MAX(headerCount, MAX(16, _headerCapacity * 2));
+        _headers = realloc(_headers, sizeof(NSInteger) * _headerCapacity);
+    }
+    __block NSInteger section = 0;
+    NSInteger *headers = _headers;
+    [_headerIndices enumerateIndexesInRange:NSMakeRange(0, (NSUInteger)MAX(0, itemCount)) options:0 usingBlock:^(NSUInteger index, BOOL *stop) {
+        headers[section++] = (NSInteger)index;
+    }];
+    _sectionCount = headerCount;
+
+    CGFloat *lengths = malloc(sizeof(CGFloat) * MAX(headerCount, 1));
+    _leadingOffset = headerCount > 0 ? [itemOffsets offsetAtIndex:_headers[0]] : 0;
+    CGFloat start = _leadingOffset;
+    for (NSInteger s = 0; s < headerCount; s++) {
+        NSInteger nextStartIndex = (s + 1 < headerCount) ? _headers[s + 1] : itemCount;
+        CGFloat end = [itemOffsets offsetAtIndex:nextStartIndex];
+        lengths[s] = end - start;
+        start = end;
+    }
+    [_sections resetWithLengths:lengths count:headerCount];
+    free(lengths);
+}
+
+#pragma mark - Queries
+
+- (NSInteger)sectionForOffset:(CGFloat)offset
+{
+    if (_sectionCount == 0 || offset < _leadingOffset) {
+        return NSNotFound;
+    }
+    return MIN([_sections indexForOffset:offset - _leadingOffset], _sectionCount - 1);
+}
+
+- (NSInteger)sectionForItemAtIndex:(NSInteger)index
+{
+    if (_sectionCount == 0 || index < _headers[0]) {
+        return NSNotFound;
+    }
+    // Last header at or before index
+    NSInteger low = 0;
+    NSInteger high = _sectionCount - 1;
+    while (low < high) {
+        NSInteger mid = low + (high - low + 1) / 2;
+        if (_headers[mid] <= index) {
+            low = mid;
+        } else {
+            high = mid - 1;
+        }
+    }
+    return low;
+}
+
+- (NSInteger)headerIndexForSection:(NSInteger)section
+{
+    if (section < 0 || section >= _sectionCount) {
+        return NSNotFound;
+    }
+    return _headers[section];
+}
+
+- (CGFloat)startOffsetOfSection:(NSInteger)section
+{
+    return _leadingOffset + [_sections offsetAtIndex:section];
+}
+
+- (CGFloat)endOffsetOfSection:(NSInteger)section
+{
+    return _leadingOffset + [_sections endOffsetAtIndex:section];
+}
+
+- (CGFloat)pinnedOffsetForSection:(NSInteger)section
+                     scrollOffset:(CGFloat)scrollOffset
+                     headerLength:(CGFloat)headerLength
+{
+    if (section < 0 || section >= _sectionCount) {
+        return 0;
+    }
+    CGFloat start = [self startOffsetOfSection:section];
+    CGFloat end = [self endOffsetOfSection:section];
+    // The next header pushes this one out instead of overlapping it
+    return MAX(start, MIN(scrollOffset, end - headerLength));
+}
+
+@end
@@ -12,6 +12,9 @@ NS_ASSUME_NONNULL_BEGIN
 // Layout configuration (set from native view props)
 @property (nonatomic, assign) BOOL horizontal;
 @property (nonatomic, assign) CGSize estimatedItemSize;
+@property (nonatomic, copy) NSString *layoutType; // "list" or "grid"; horizontal grids are rowCount rows tall
+@property (nonatomic, assign) NSInteger rowCount;
+@property (nonatomic, copy, nullable) NSArray<NSString *> *itemKeys; // Stamped onto item metadata by each child's item index
 
 // Public method to get local data snapshot
 - (SmartCollectionViewLocalData *)localDataSnapshot;
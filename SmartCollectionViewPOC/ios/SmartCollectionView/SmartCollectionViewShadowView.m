@@ -2,6 +2,7 @@
 #import <React/RCTLog.h>
 #import <React/RCTShadowView+Layout.h>
 #import "SmartCollectionViewLocalData.h"
+#import "SmartCollectionViewItemShadowView.h"
 #import "SmartCollectionViewManager.h"
 #import "SmartCollectionView.h"
 #import <React/RCTBridge.h>
@@ -36,6 +37,8 @@
         _currentMaxHeight = 0;
         _horizontal = YES;
         _estimatedItemSize = CGSizeMake(100, 80);
+        _layoutType = @"list";
+        _rowCount = 2;
         
         // Note: Cannot use measureFunc because Yoga doesn't allow nodes with
         // measure functions to have children. Instead, we calculate height
@@ -98,10 +101,16 @@
 - (void)layoutSubviewsWithContext:(RCTLayoutContext)layoutContext
 {
     [super layoutSubviewsWithContext:layoutContext];
+
+    // Vertical lists are sized by their parent; only publish the measured children
+    if (!_horizontal) {
+        [self updateLocalDataIfNeeded];
+        return;
+    }
     
     // Calculate max height from children after Yoga has laid them out
     // This allows us to measure children's actual sizes
-    CGFloat newMaxHeight = [self calculateMaxItemHeight];
+    CGFloat newMaxHeight = [self calculateMaxItemHeight] * [self stackedRowCount];
     
     SCVShadowLog(@"layoutSubviewsWithContext: currentMaxHeight=%.2f, newMaxHeight=%.2f, children=%lu", 
                  _currentMaxHeight, newMaxHeight, (unsigned long)_mutableChildShadowViews.count);
@@ -149,7 +158,7 @@
     } else if (_currentMaxHeight == 0 && newMaxHeight == 0 && _estimatedItemSize.height > 0) {
         // Use estimated height if no children yet
         SCVShadowLog(@"Using estimated height: %.2f", _estimatedItemSize.height);
-        YGValue heightValue = {_estimatedItemSize.height, YGUnitPoint};
+        YGValue heightValue = {_estimatedItemSize.height * [self stackedRowCount], YGUnitPoint};
         self.height = heightValue;
         
         // Mark ourselves as dirty
@@ -166,6 +175,48 @@
     [self updateLocalDataIfNeeded];
 }
 
+- (void)setHorizontal:(BOOL)horizontal
+{
+    if (_horizontal == horizontal) {
+        return;
+    }
+    _horizontal = horizontal;
+    if (!horizontal && _currentMaxHeight > 0) {
+        // Hand the height back to the parent's flex layout
+        _currentMaxHeight = 0;
+        self.height = YGValueAuto;
+    }
+    [self dirtyLayout];
+}
+
+- (void)setLayoutType:(NSString *)layoutType
+{
+    _layoutType = [layoutType copy] ?: @"list";
+    [self dirtyLayout];
+}
+
+- (void)setRowCount:(NSInteger)rowCount
+{
+    _rowCount = rowCount;
+    [self dirtyLayout];
+}
+
+// Rows of the tallest item the view is as tall as: 1 for lists, rowCount for grids
+- (NSInteger)stackedRowCount
+{
+    if (![_layoutType isEqualToString:@"grid"]) {
+        return 1;
+    }
+    NSInteger children = MAX(1, (NSInteger)_mutableChildShadowViews.count);
+    return MAX(1, MIN(_rowCount, children));
+}
+
+- (void)setItemKeys:(NSArray<NSString *> *)itemKeys
+{
+    _itemKeys = [itemKeys copy];
+    [self dirtyLayout]; // Republish local data with the new keys
+}
+
 - (void)dirtyLayout
 {
     [super dirtyLayout];
@@ -180,8 +231,17 @@
 
     NSMutableArray<SmartCollectionViewItemMetadata *> *items = [NSMutableArray arrayWithCapacity:_mutableChildShadowViews.count];
 
-    NSInteger index = 0;
     for (RCTShadowView *shadowView in _mutableChildShadowViews) {
+        // Stamp the data index the child carries; its position among the children
+        // skips every index that is not rendered
+        if (![shadowView isKindOfClass:[SmartCollectionViewItemShadowView class]]) {
+            continue;
+        }
+        NSInteger index = ((SmartCollectionViewItemShadowView *)shadowView).itemIndex;
+        if (index < 0) {
+            continue;
+        }
+
         RCTLayoutMetrics metrics = shadowView.layoutMetrics;
         CGSize size = metrics.frame.size;
 
@@ -194,8 +254,10 @@
                                                                                                             size:size
                                                                                                            index:index
                                                                                                           version:_localDataVersion];
+        if (index < (NSInteger)_itemKeys.count) {
+            metadata.key = _itemKeys[index];
+        }
         [items addObject:metadata];
-        index++;
     }
 
     SmartCollectionViewLocalData *localData = [[SmartCollectionViewLocalData alloc] initWithItems:[items copy]
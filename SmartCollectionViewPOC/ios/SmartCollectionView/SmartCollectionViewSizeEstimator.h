@@ -0,0 +1,28 @@
+#import <Foundation/Foundation.h>
+#import <CoreGraphics/CoreGraphics.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+// Learns item sizes online from measured metadata.
+// Running mean and variance (Welford) per (item type, layout width) bucket,
+// plus an all-types bucket per layout width. Each item counts once: a new
+// measurement of the same item replaces its previous sample.
+@interface SmartCollectionViewSizeEstimator : NSObject
+
+@property (nonatomic, assign) NSInteger minimumSamples;         // Samples a bucket needs before it is trusted (default: 3)
+@property (nonatomic, assign, readonly) NSUInteger sampleCount; // Items currently contributing
+
+// item: stable identity of the measured item (react tag or item key)
+// width: list width the item was laid out against; rounded to whole points
+- (void)recordSize:(CGSize)size forItem:(id<NSCopying>)item type:(nullable NSString *)type layoutWidth:(CGFloat)width;
+- (void)removeItem:(id<NSCopying>)item;
+
+// Mean of the type's bucket, else of every type at this width; NO when neither is trusted yet
+- (BOOL)getEstimatedSize:(CGSize * _Nullable)size forType:(nullable NSString *)type layoutWidth:(CGFloat)width;
+// Per-axis standard deviation of the bucket getEstimatedSize: would use; CGSizeZero without samples
+- (CGSize)standardDeviationForType:(nullable NSString *)type layoutWidth:(CGFloat)width;
+- (void)reset;
+
+@end
+
+NS_ASSUME_NONNULL_END
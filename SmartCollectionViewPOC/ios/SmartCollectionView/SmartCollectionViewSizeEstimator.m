@@ -0,0 +1,184 @@
+#import "SmartCollectionViewSizeEstimator.h"
+#import <math.h>
+
+// Welford accumulator for one bucket
+@interface SmartCollectionViewSizeStatistics : NSObject
+@property (nonatomic, assign) NSInteger count;
+@property (nonatomic, assign) CGSize mean;
+@property (nonatomic, assign) CGSize m2; // Sum of squared deviations from the mean
+@end
+
+@implementation SmartCollectionViewSizeStatistics
+
+- (void)addSize:(CGSize)size
+{
+    self.count += 1;
+    CGSize delta = CGSizeMake(size.width - self.mean.width, size.height - self.mean.height);
+    CGSize mean = CGSizeMake(self.mean.width + delta.width / self.count, self.mean.height + delta.height / self.count);
+    self.m2 = CGSizeMake(self.m2.width + delta.width * (size.width - mean.width),
+                         self.m2.height + delta.height * (size.height - mean.height));
+    self.mean = mean;
+}
+
+- (void)removeSize:(CGSize)size
+{
+    if (self.count <= 1) {
+        self.count = 0;
+        self.mean = CGSizeZero;
+        self.m2 = CGSizeZero;
+        return;
+    }
+    // Welford in reverse
+    CGSize mean = CGSizeMake((self.mean.width * self.count - size.width) / (self.count - 1),
+                             (self.mean.height * self.count - size.height) / (self.count - 1));
+    self.m2 = CGSizeMake(MAX(0, self.m2.width - (size.width - self.mean.width) * (size.width - mean.width)),
+                         MAX(0, self.m2.height - (size.height - self.mean.height) * (size.height - mean.height)));
+    self.mean = mean;
+    self.count -= 1;
+}
+
+- (CGSize)standardDeviation
+{
+    if (self.count < 2) {
+        return CGSizeZero;
+    }
+    return CGSizeMake(sqrt(self.m2.width / (self.count - 1)), sqrt(self.m2.height / (self.count - 1)));
+}
+
+@end
+
+// Last sample an item contributed
+@interface SmartCollectionViewSizeSample : NSObject
+@property (nonatomic, assign) CGSize size;
+@property (nonatomic, copy, nullable) NSString *type;
+@property (nonatomic, assign) NSInteger width;
+@end
+
+@implementation SmartCollectionViewSizeSample
+@end
+
+@interface SmartCollectionViewSizeEstimator ()
+
+@property (nonatomic, strong) NSMutableDictionary<NSNumber *, NSMutableDictionary<NSString *, SmartCollectionViewSizeStatistics *> *> *statsByWidthAndType;
+@property (nonatomic, strong) NSMutableDictionary<NSNumber *, SmartCollectionViewSizeStatistics *> *statsByWidth;
+@property (nonatomic, strong) NSMutableDictionary<id<NSCopying>, SmartCollectionViewSizeSample *> *samplesByItem;
+
+@end
+
+@implementation SmartCollectionViewSizeEstimator
+
+- (instancetype)init
+{
+    self = [super init];
+    if (self) {
+        _minimumSamples = 3;
+        _statsByWidthAndType = [NSMutableDictionary dictionary];
+        _statsByWidth = [NSMutableDictionary dictionary];
+        _samplesByItem = [NSMutableDictionary dictionary];
+    }
+    return self;
+}
+
+- (NSUInteger)sampleCount
+{
+    return self.samplesByItem.count;
+}
+
+// type nil: the all-types bucket for the width
+- (SmartCollectionViewSizeStatistics *)statisticsForType:(NSString *)type width:(NSInteger)width create:(BOOL)create
+{
+    NSNumber *widthKey = @(width);
+    NSMutableDictionary *table = self.statsByWidth;
+    id key = widthKey;
+    if (type.length > 0) {
+        table = self.statsByWidthAndType[widthKey];
+        if (!table && create) {
+            table = [NSMutableDictionary dictionary];
+            self.statsByWidthAndType[widthKey] = table;
+        }
+        key = type;
+    }
+    SmartCollectionViewSizeStatistics *stats = table[key];
+    if (!stats && create) {
+        stats = [[SmartCollectionViewSizeStatistics alloc] init];
+        table[key] = stats;
+    }
+    return stats;
+}
+
+- (void)recordSize:(CGSize)size forItem:(id<NSCopying>)item type:(NSString *)type layoutWidth:(CGFloat)width
+{
+    if (size.width <= 0 || size.height <= 0) {
+        return;
+    }
+    NSInteger roundedWidth = (NSInteger)lround(width);
+    SmartCollectionViewSizeSample *previous = self.samplesByItem[item];
+    if (previous && CGSizeEqualToSize(previous.size, size) && previous.width == roundedWidth &&
+        (previous.type == type || [previous.type isEqualToString:type])) {
+        return;
+    }
+    [self removeItem:item];
+
+    [[self statisticsForType:nil width:roundedWidth create:YES] addSize:size];
+    if (type.length > 0) {
+        [[self statisticsForType:type width:roundedWidth create:YES] addSize:size];
+    }
+    SmartCollectionViewSizeSample *sample = [[SmartCollectionViewSizeSample alloc] init];
+    sample.size = size;
+    sample.type = type;
+    sample.width = roundedWidth;
+    self.samplesByItem[item] = sample;
+}
+
+- (void)removeItem:(id<NSCopying>)item
+{
+    SmartCollectionViewSizeSample *sample = self.samplesByItem[item];
+    if (!sample) {
+        return;
+    }
+    [[self statisticsForType:nil width:sample.width create:NO] removeSize:sample.size];
+    if (sample.type.length > 0) {
+        [[self statisticsForType:sample.type width:sample.width create:NO] removeSize:sample.size];
+    }
+    [self.samplesByItem removeObjectForKey:item];
+}
+
+// Type bucket when trusted, else the all-types bucket when trusted
+- (SmartCollectionViewSizeStatistics *)trustedStatisticsForType:(NSString *)type width:(CGFloat)width
+{
+    NSInteger roundedWidth = (NSInteger)lround(width);
+    NSInteger minimum = MAX(1, self.minimumSamples);
+    SmartCollectionViewSizeStatistics *stats = type.length > 0 ? [self statisticsForType:type width:roundedWidth create:NO] : nil;
+    if (stats.count >= minimum) {
+        return stats;
+    }
+    stats = [self statisticsForType:nil width:roundedWidth create:NO];
+    return stats.count >= minimum ? stats : nil;
+}
+
+- (BOOL)getEstimatedSize:(CGSize *)size forType:(NSString *)type layoutWidth:(CGFloat)width
+{
+    SmartCollectionViewSizeStatistics *stats = [self trustedStatisticsForType:type width:width];
+    if (!stats) {
+        return NO;
+    }
+    if (size) {
+        *size = stats.mean;
+    }
+    return YES;
+}
+
+- (CGSize)standardDeviationForType:(NSString *)type layoutWidth:(CGFloat)width
+{
+    SmartCollectionViewSizeStatistics *stats = [self trustedStatisticsForType:type width:width];
+    return stats ? [stats standardDeviation] : CGSizeZero;
+}
+
+- (void)reset
+{
+    [self.statsByWidthAndType removeAllObjects];
+    [self.statsByWidth removeAllObjects];
+    [self.samplesByItem removeAllObjects];
+}
+
+@end
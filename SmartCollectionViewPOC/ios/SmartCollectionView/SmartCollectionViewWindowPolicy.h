@@ -0,0 +1,32 @@
+#import <Foundation/Foundation.h>
+#import <CoreGraphics/CoreGraphics.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+// Item padding applied on each side of a window (before = lower indices, after = higher indices)
+typedef struct {
+    NSInteger before;
+    NSInteger after;
+} SmartCollectionViewWindowPadding;
+
+// Decides how a symmetric buffer is split around the viewport.
+// In predictive mode the split skews toward the scroll direction in proportion
+// to a smoothed scroll velocity; otherwise it stays symmetric.
+@interface SmartCollectionViewWindowPolicy : NSObject
+
+@property (nonatomic, assign, getter=isPredictive) BOOL predictive;       // Default: NO
+@property (nonatomic, assign) CGFloat smoothingFactor;                    // EWMA weight of the newest sample (default: 0.3)
+@property (nonatomic, assign) CGFloat saturationVelocity;                 // points/sec at which skew is maximal (default: 3000)
+@property (nonatomic, assign) CGFloat maxSkew;                            // 0..1 share of the trailing buffer moved ahead (default: 0.8)
+@property (nonatomic, assign, readonly) CGFloat velocity;                 // Smoothed, points/sec; positive = toward higher indices
+
+// Feed scroll offsets along the scroll axis (from scrollViewDidScroll:)
+- (void)recordOffset:(CGFloat)offset atTime:(NSTimeInterval)time;
+// Forget velocity history (scroll ended or content changed)
+- (void)reset;
+
+- (SmartCollectionViewWindowPadding)paddingForBuffer:(NSInteger)buffer;
+
+@end
+
+NS_ASSUME_NONNULL_END
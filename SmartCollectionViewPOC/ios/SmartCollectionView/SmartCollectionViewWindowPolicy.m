@@ -0,0 +1,93 @@
+#import "SmartCollectionViewWindowPolicy.h"
+
+// Samples further apart than this belong to a new gesture, not a continuation
+static const NSTimeInterval kMaxSampleGap = 0.25;
+
+@interface SmartCollectionViewWindowPolicy ()
+
+@property (nonatomic, assign, readwrite) CGFloat velocity;
+@property (nonatomic, assign) CGFloat lastOffset;
+@property (nonatomic, assign) NSTimeInterval lastTime;
+@property (nonatomic, assign) BOOL hasSample;
+
+@end
+
+@implementation SmartCollectionViewWindowPolicy
+
+- (instancetype)init
+{
+    self = [super init];
+    if (self) {
+        _predictive = NO;
+        _smoothingFactor = 0.3;
+        _saturationVelocity = 3000.0;
+        _maxSkew = 0.8;
+        _velocity = 0;
+        _lastOffset = 0;
+        _lastTime = 0;
+        _hasSample = NO;
+    }
+    return self;
+}
+
+- (void)recordOffset:(CGFloat)offset atTime:(NSTimeInterval)time
+{
+    if (!self.hasSample) {
+        self.lastOffset = offset;
+        self.lastTime = time;
+        self.hasSample = YES;
+        return;
+    }
+
+    NSTimeInterval dt = time - self.lastTime;
+    CGFloat delta = offset - self.lastOffset;
+    if (delta == 0 || dt <= 0) {
+        // Same offset re-reported (layout pass) or same frame: nothing to learn
+        return;
+    }
+
+    self.lastOffset = offset;
+    self.lastTime = time;
+
+    if (dt > kMaxSampleGap) {
+        self.velocity = 0;
+        return;
+    }
+
+    CGFloat instantaneous = delta / dt;
+    CGFloat alpha = MIN(MAX(self.smoothingFactor, 0), 1);
+    self.velocity = alpha * instantaneous + (1.0 - alpha) * self.velocity;
+}
+
+- (void)reset
+{
+    self.velocity = 0;
+    self.hasSample = NO;
+}
+
+- (SmartCollectionViewWindowPadding)paddingForBuffer:(NSInteger)buffer
+{
+    SmartCollectionViewWindowPadding padding = { MAX(0, buffer), MAX(0, buffer) };
+    if (!self.predictive || buffer <= 0 || self.saturationVelocity <= 0) {
+        return padding;
+    }
+
+    CGFloat speed = fabs(self.velocity);
+    CGFloat skew = MIN(MAX(self.maxSkew, 0), 1) * MIN(speed / self.saturationVelocity, 1.0);
+
+    // Total padding stays 2 * buffer; the skewed share moves ahead of the scroll
+    NSInteger shifted = (NSInteger)lround(buffer * skew);
+    NSInteger ahead = buffer + shifted;
+    NSInteger behind = buffer - shifted;
+
+    if (self.velocity > 0) {
+        padding.before = behind;
+        padding.after = ahead;
+    } else if (self.velocity < 0) {
+        padding.before = ahead;
+        padding.after = behind;
+    }
+    return padding;
+}
+
+@end
@@ -0,0 +1,20 @@
+#import "SmartCollectionViewLayoutProvider.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+// Vertically scrolling grid filled row by row. The column count is derived
+// from the viewport width: as many columns of at least minimumItemWidth as
+// fit, sharing the width equally. Each row is as tall as its tallest item;
+// row heights live in an offset index, so resizing one item refreshes its
+// row in O(columns) and shifts the rows below it in O(log n). A width change
+// (rotation) goes through prepareWithSizes:count:viewport: again.
+@interface VerticalGridLayoutProvider : NSObject <SmartCollectionViewLayoutProvider>
+
+@property (nonatomic, assign) CGFloat minimumItemWidth;  // Re-run prepareWithSizes after changing (default: 100)
+@property (nonatomic, assign) CGSize estimatedItemSize;  // Used for zero sizes (default: 100x80)
+@property (nonatomic, assign, readonly) NSInteger columnCount;
+@property (nonatomic, assign, readonly) CGFloat columnWidth;
+
+@end
+
+NS_ASSUME_NONNULL_END
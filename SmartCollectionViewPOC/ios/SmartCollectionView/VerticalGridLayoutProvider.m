@@ -0,0 +1,163 @@
+#import "VerticalGridLayoutProvider.h"
+#import "SmartCollectionViewOffsetIndex.h"
+#import <stdlib.h>
+#import <math.h>
+
+@implementation VerticalGridLayoutProvider
+{
+    CGFloat *_itemHeights; // resolved height per item; a row's height is the max of its columnCount entries
+    NSInteger _capacity;
+    NSInteger _itemCount;
+    CGFloat _width;        // viewport width captured by the last prepare
+    SmartCollectionViewOffsetIndex *_rows; // row heights along y
+}
+
+- (instancetype)init
+{
+    self = [super init];
+    if (self) {
+        _minimumItemWidth = 100;
+        _estimatedItemSize = CGSizeMake(100, 80);
+        _itemHeights = NULL;
+        _capacity = 0;
+        _itemCount = 0;
+        _width = 0;
+        _columnCount = 1;
+        _columnWidth = 0;
+        _rows = [[SmartCollectionViewOffsetIndex alloc] init];
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    free(_itemHeights);
+}
+
+- (NSString *)layoutType {
+    return @"verticalGrid";
+}
+
+- (NSInteger)itemCount
+{
+    return _itemCount;
+}
+
+- (CGFloat)heightOfRow:(NSInteger)row
+{
+    NSInteger start = row * _columnCount;
+    NSInteger end = MIN(start + _columnCount, _itemCount);
+    CGFloat height = 0;
+    for (NSInteger i = start; i < end; i++) {
+        height = MAX(height, _itemHeights[i]);
+    }
+    return height;
+}
+
+- (CGFloat)resolvedHeight:(CGSize)size
+{
+    return size.height > 0 ? size.height : _estimatedItemSize.height;
+}
+
+#pragma mark - Sizes
+
+- (void)prepareWithSizes:(const CGSize *)sizes count:(NSInteger)count viewport:(CGSize)viewport
+{
+    count = MAX(0, count);
+    if (count > _capacity) {
+        _capacity = MAX(count, MAX(64, _capacity * 2));
+        _itemHeights = realloc(_itemHeights, sizeof(CGFloat) * _capacity);
+    }
+    _itemCount = count;
+
+    // Before the first layout there is no width; lay out a single column of estimated width
+    _width = viewport.width > 0 ? viewport.width : _estimatedItemSize.width;
+    CGFloat minimumWidth = MAX(1, _minimumItemWidth);
+    _columnCount = MAX(1, (NSInteger)floor(_width / minimumWidth));
+    _columnWidth = _width / _columnCount;
+
+    for (NSInteger i = 0; i < count; i++) {
+        _itemHeights[i] = [self resolvedHeight:sizes[i]];
+    }
+    NSInteger rowCount = (count + _columnCount - 1) / _columnCount;
+    CGFloat *rowHeights = malloc(sizeof(CGFloat) * MAX(rowCount, 1));
+    for (NSInteger row = 0; row < rowCount; row++) {
+        rowHeights[row] = [self heightOfRow:row];
+    }
+    [_rows resetWithLengths:rowHeights count:rowCount];
+    free(rowHeights);
+}
+
+- (BOOL)setSize:(CGSize)size atIndex:(NSInteger)index
+{
+    if (index < 0 || index >= _itemCount) {
+        return NO;
+    }
+    // Widths come from the grid; only the height can move anything
+    CGFloat height = [self resolvedHeight:size];
+    if (_itemHeights[index] == height) {
+        return NO;
+    }
+    _itemHeights[index] = height;
+    NSInteger row = index / _columnCount;
+    return [_rows setLength:[self heightOfRow:row] atIndex:row];
+}
+
+#pragma mark - Queries
+
+- (CGSize)contentSize
+{
+    if (_itemCount == 0) {
+        return CGSizeZero;
+    }
+    return CGSizeMake(_width, _rows.totalLength);
+}
+
+- (CGRect)frameForItemAtIndex:(NSInteger)index
+{
+    if (index < 0 || index >= _itemCount) {
+        return CGRectNull;
+    }
+    NSInteger row = index / _columnCount;
+    NSInteger column = index % _columnCount;
+    return CGRectMake(column * _columnWidth, [_rows offsetAtIndex:row], _columnWidth, [_rows lengthAtIndex:row]);
+}
+
+- (void)enumerateItemsInRect:(CGRect)rect
+                  usingBlock:(void (NS_NOESCAPE ^)(NSInteger index, CGRect frame, BOOL *stop))block
+{
+    if (_itemCount == 0 || _columnWidth <= 0 || CGRectIsNull(rect)) {
+        return;
+    }
+
+    // Columns are uniform, so the column span is O(1)
+    NSInteger firstColumn = MAX(0, (NSInteger)floor(CGRectGetMinX(rect) / _columnWidth));
+    NSInteger lastColumn = MIN(_columnCount - 1, (NSInteger)ceil(CGRectGetMaxX(rect) / _columnWidth) - 1);
+    if (firstColumn > lastColumn) {
+        return;
+    }
+
+    // O(log n) to the first row, then O(columns) per row walking down
+    NSInteger rowCount = _rows.count;
+    CGFloat maxY = CGRectGetMaxY(rect);
+    NSInteger row = [_rows indexForOffset:CGRectGetMinY(rect)];
+    CGFloat y = row < rowCount ? [_rows offsetAtIndex:row] : 0;
+    BOOL stop = NO;
+    while (row < rowCount && y < maxY) {
+        CGFloat height = [_rows lengthAtIndex:row];
+        for (NSInteger column = firstColumn; column <= lastColumn; column++) {
+            NSInteger index = row * _columnCount + column;
+            if (index >= _itemCount) {
+                break;
+            }
+            block(index, CGRectMake(column * _columnWidth, y, _columnWidth, height), &stop);
+            if (stop) {
+                return;
+            }
+        }
+        y += height;
+        row++;
+    }
+}
+
+@end
@@ -0,0 +1,108 @@
+#import "SCVTestSupport.h"
+#import "SmartCollectionViewLayoutCache.h"
+
+static SmartCollectionViewLayoutCache *SCVMakeCache(NSInteger count)
+{
+    SmartCollectionViewLayoutCache *cache = [[SmartCollectionViewLayoutCache alloc] init];
+    for (NSInteger i = 0; i < count; i++) {
+        [cache setFrame:CGRectMake(0, i * 10, 100, 10) forIndex:i];
+    }
+    return cache;
+}
+
+static void testStoreAndRead(void)
+{
+    SmartCollectionViewLayoutCache *cache = SCVMakeCache(600); // Spans three pages
+
+    SCVAssertEqual(cache.count, 600u);
+    SCVAssertRectEqual([cache frameForIndex:300], CGRectMake(0, 3000, 100, 10));
+    SCVAssert(CGRectIsNull([cache frameForIndex:600]));
+    SCVAssertEqual([cache stateForIndex:5], SmartCollectionViewLayoutStateExact);
+    SCVAssertEqual([cache stateForIndex:600], SmartCollectionViewLayoutStateMetadata);
+
+    __block NSInteger visited = 0;
+    [cache enumerateFramesInRange:NSMakeRange(250, 10) usingBlock:^(NSInteger index, CGRect frame, BOOL *stop) {
+        SCVAssertRectEqual(frame, CGRectMake(0, index * 10, 100, 10));
+        visited++;
+    }];
+    SCVAssertEqual(visited, 10);
+}
+
+static void testVersions(void)
+{
+    SmartCollectionViewLayoutCache *cache = SCVMakeCache(1);
+    NSInteger version = [cache versionForIndex:0];
+
+    [cache setFrame:CGRectMake(0, 0, 100, 10) forIndex:0];
+    SCVAssertEqual([cache versionForIndex:0], version); // Same frame
+    [cache setFrame:CGRectMake(0, 0, 100, 20) forIndex:0];
+    SCVAssertEqual([cache versionForIndex:0], version + 1);
+
+    [cache invalidateIndex:0];
+    SCVAssertEqual([cache stateForIndex:0], SmartCollectionViewLayoutStateEstimated);
+    SCVAssertEqual([cache versionForIndex:0], version + 2);
+    SCVAssertEqual([cache versionForIndex:1], -1);
+}
+
+static void testInvalidateRange(void)
+{
+    SmartCollectionViewLayoutCache *cache = SCVMakeCache(100);
+
+    [cache invalidateRange:NSMakeRange(40, 20)];
+    SCVAssert([cache hasFrameForIndex:39]);
+    SCVAssert(![cache hasFrameForIndex:40]);
+    SCVAssert(![cache hasFrameForIndex:59]);
+    SCVAssert([cache hasFrameForIndex:60]);
+
+    // A frame stored after the invalidation is current again
+    [cache setFrame:CGRectMake(0, 450, 100, 10) forIndex:45];
+    SCVAssertRectEqual([cache frameForIndex:45], CGRectMake(0, 450, 100, 10));
+
+    __block NSInteger visited = 0;
+    [cache enumerateFramesInRange:NSMakeRange(0, 100) usingBlock:^(NSInteger index, CGRect frame, BOOL *stop) {
+        visited++;
+    }];
+    SCVAssertEqual(visited, 81);
+}
+
+static void testInvalidateAll(void)
+{
+    SmartCollectionViewLayoutCache *cache = SCVMakeCache(300);
+
+    [cache invalidateAll];
+    SCVAssert(![cache hasFrameForIndex:0]);
+    SCVAssert(![cache hasFrameForIndex:299]);
+    SCVAssert([cache specForIndex:10] == nil);
+
+    [cache setFrame:CGRectMake(0, 0, 50, 50) forIndex:0];
+    SCVAssert([cache hasFrameForIndex:0]);
+}
+
+static void testColdEviction(void)
+{
+    SmartCollectionViewLayoutCache *cache = SCVMakeCache(100);
+    NSUInteger entryBytes = [SmartCollectionViewLayoutCache bytesPerEntry];
+    [cache setMemoryBudget:10 * entryBytes forTier:SmartCollectionViewLayoutTierCold];
+
+    // Buffer hull is 40..<70, so 70 frames are cold and 60 have to go;
+    // scrolling forward evicts behind the scroll first
+    NSUInteger evicted = [cache evictWithVisibleRange:NSMakeRange(50, 10) bufferRange:NSMakeRange(40, 30) direction:1];
+    SCVAssertEqual(evicted, 60u);
+    SCVAssertEqual(cache.evictionCount, 60u);
+    SCVAssert(![cache hasFrameForIndex:0]);
+    SCVAssert(![cache hasFrameForIndex:39]);
+    SCVAssert([cache hasFrameForIndex:40]);
+    SCVAssert([cache hasFrameForIndex:79]);
+    SCVAssert(![cache hasFrameForIndex:80]);
+    SCVAssertEqual([cache stateForIndex:0], SmartCollectionViewLayoutStateMetadata);
+}
+
+int main(void)
+{
+    SCVRunTest(testStoreAndRead);
+    SCVRunTest(testVersions);
+    SCVRunTest(testInvalidateRange);
+    SCVRunTest(testInvalidateAll);
+    SCVRunTest(testColdEviction);
+    return SCVTestResult();
+}
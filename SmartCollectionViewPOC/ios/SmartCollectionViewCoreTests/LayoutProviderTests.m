@@ -0,0 +1,184 @@
+#import "SCVTestSupport.h"
+#import "HorizontalGridLayoutProvider.h"
+#import "VerticalGridLayoutProvider.h"
+#import "MasonryLayoutProvider.h"
+
+// Rect queries must return exactly the items whose frames intersect the rect
+static void SCVAssertRectQueryMatchesFrames(id<SmartCollectionViewLayoutProvider> provider, CGRect rect)
+{
+    NSMutableIndexSet *expected = [NSMutableIndexSet indexSet];
+    for (NSInteger i = 0; i < provider.itemCount; i++) {
+        if (CGRectIntersectsRect([provider frameForItemAtIndex:i], rect)) {
+            [expected addIndex:i];
+        }
+    }
+    NSMutableIndexSet *actual = [NSMutableIndexSet indexSet];
+    [provider enumerateItemsInRect:rect usingBlock:^(NSInteger index, CGRect frame, BOOL *stop) {
+        SCVAssertRectEqual(frame, [provider frameForItemAtIndex:index]);
+        [actual addIndex:index];
+    }];
+    SCVAssert([actual isEqualToIndexSet:expected], @"%@ rect {%g, %g, %g, %g}: got %@, expected %@",
+              [provider layoutType], rect.origin.x, rect.origin.y, rect.size.width, rect.size.height, actual, expected);
+}
+
+static void SCVAssertRectQueriesMatchFrames(id<SmartCollectionViewLayoutProvider> provider)
+{
+    CGSize content = [provider contentSize];
+    for (CGFloat y = -20; y < content.height + 20; y += 37) {
+        for (CGFloat x = -20; x < content.width + 20; x += 53) {
+            SCVAssertRectQueryMatchesFrames(provider, CGRectMake(x, y, 90, 70));
+        }
+    }
+}
+
+#pragma mark - Horizontal grid
+
+static void testHorizontalGridFrames(void)
+{
+    // Two rows; zero sizes take the estimate (100x80)
+    CGSize sizes[] = {{50, 30}, {70, 40}, {60, 20}, {10, 10}, {0, 0}};
+    HorizontalGridLayoutProvider *grid = [[HorizontalGridLayoutProvider alloc] init];
+    [grid prepareWithSizes:sizes count:5 viewport:CGSizeMake(320, 200)];
+
+    // Columns are as wide as their widest item, rows as tall as the tallest item
+    SCVAssertRectEqual([grid frameForItemAtIndex:0], CGRectMake(0, 0, 70, 80));
+    SCVAssertRectEqual([grid frameForItemAtIndex:3], CGRectMake(70, 80, 60, 80));
+    SCVAssertRectEqual([grid frameForItemAtIndex:4], CGRectMake(130, 0, 100, 80));
+    SCVAssert(CGRectIsNull([grid frameForItemAtIndex:5]));
+    SCVAssert(CGSizeEqualToSize([grid contentSize], CGSizeMake(230, 160)));
+}
+
+static void testHorizontalGridResize(void)
+{
+    CGSize sizes[] = {{50, 30}, {70, 40}, {60, 20}, {10, 10}, {0, 0}};
+    HorizontalGridLayoutProvider *grid = [[HorizontalGridLayoutProvider alloc] init];
+    [grid prepareWithSizes:sizes count:5 viewport:CGSizeMake(320, 200)];
+
+    SCVAssert([grid setSize:CGSizeMake(20, 10) atIndex:4]);
+    SCVAssertRectEqual([grid frameForItemAtIndex:4], CGRectMake(130, 0, 20, 40));
+    SCVAssert(![grid setSize:CGSizeMake(20, 10) atIndex:4], @"same size reports no change");
+    SCVAssert(![grid setSize:CGSizeMake(20, 10) atIndex:5], @"out of range is ignored");
+}
+
+static void testHorizontalGridRectQueries(void)
+{
+    CGSize sizes[200];
+    for (NSInteger i = 0; i < 200; i++) {
+        sizes[i] = CGSizeMake(40 + (i * 13) % 50, 60);
+    }
+    HorizontalGridLayoutProvider *grid = [[HorizontalGridLayoutProvider alloc] init];
+    grid.rowCount = 3;
+    [grid prepareWithSizes:sizes count:200 viewport:CGSizeMake(320, 180)];
+    SCVAssertRectQueriesMatchFrames(grid);
+}
+
+#pragma mark - Vertical grid
+
+static void testVerticalGridFrames(void)
+{
+    CGSize sizes[] = {{0, 50}, {0, 70}, {0, 60}, {0, 40}, {0, 0}};
+    VerticalGridLayoutProvider *grid = [[VerticalGridLayoutProvider alloc] init];
+    grid.minimumItemWidth = 100;
+    [grid prepareWithSizes:sizes count:5 viewport:CGSizeMake(350, 600)];
+
+    // 350 fits three columns of at least 100, sharing the width
+    SCVAssertEqual(grid.columnCount, 3);
+    SCVAssertClose(grid.columnWidth, 350.0 / 3.0);
+    SCVAssertRectEqual([grid frameForItemAtIndex:1], CGRectMake(350.0 / 3.0, 0, 350.0 / 3.0, 70));
+    SCVAssertRectEqual([grid frameForItemAtIndex:4], CGRectMake(350.0 / 3.0, 70, 350.0 / 3.0, 80)); // Estimated height
+    SCVAssert(CGSizeEqualToSize([grid contentSize], CGSizeMake(350, 150)));
+
+    // Only a row's tallest item moves the rows below it
+    SCVAssert(![grid setSize:CGSizeMake(0, 65) atIndex:0]);
+    SCVAssert([grid setSize:CGSizeMake(0, 90) atIndex:2]);
+    SCVAssertRectEqual([grid frameForItemAtIndex:3], CGRectMake(0, 90, 350.0 / 3.0, 80));
+}
+
+static void testVerticalGridRectQueries(void)
+{
+    CGSize sizes[200];
+    for (NSInteger i = 0; i < 200; i++) {
+        sizes[i] = CGSizeMake(0, 30 + (i * 17) % 70);
+    }
+    VerticalGridLayoutProvider *grid = [[VerticalGridLayoutProvider alloc] init];
+    grid.minimumItemWidth = 100;
+    [grid prepareWithSizes:sizes count:200 viewport:CGSizeMake(400, 800)];
+    SCVAssertRectQueriesMatchFrames(grid);
+}
+
+#pragma mark - Masonry
+
+static void testMasonryPlacement(void)
+{
+    CGSize sizes[] = {{0, 100}, {0, 50}, {0, 80}, {0, 30}, {0, 60}, {0, 10}};
+    MasonryLayoutProvider *masonry = [[MasonryLayoutProvider alloc] init];
+    masonry.minimumItemWidth = 100;
+    [masonry prepareWithSizes:sizes count:6 viewport:CGSizeMake(300, 600)];
+
+    // Each item goes to the shortest column, ties to the leftmost
+    SCVAssertEqual(masonry.columnCount, 3);
+    SCVAssertRectEqual([masonry frameForItemAtIndex:3], CGRectMake(100, 50, 100, 30));
+    SCVAssertRectEqual([masonry frameForItemAtIndex:4], CGRectMake(100, 80, 100, 60));
+    SCVAssertRectEqual([masonry frameForItemAtIndex:5], CGRectMake(200, 80, 100, 10));
+    SCVAssert(CGSizeEqualToSize([masonry contentSize], CGSizeMake(300, 140)));
+}
+
+static void testMasonryAppendKeepsFrames(void)
+{
+    CGSize sizes[] = {{0, 100}, {0, 50}, {0, 80}, {0, 30}, {0, 60}, {0, 10}};
+    MasonryLayoutProvider *masonry = [[MasonryLayoutProvider alloc] init];
+    masonry.minimumItemWidth = 100;
+    [masonry prepareWithSizes:sizes count:6 viewport:CGSizeMake(300, 600)];
+    CGRect before[6];
+    for (NSInteger i = 0; i < 6; i++) {
+        before[i] = [masonry frameForItemAtIndex:i];
+    }
+
+    CGSize appended[] = {{0, 20}};
+    [masonry appendSizes:appended count:1];
+    SCVAssertEqual(masonry.itemCount, 7);
+    SCVAssertRectEqual([masonry frameForItemAtIndex:6], CGRectMake(200, 90, 100, 20));
+    for (NSInteger i = 0; i < 6; i++) {
+        SCVAssertRectEqual([masonry frameForItemAtIndex:i], before[i]);
+    }
+}
+
+static void testMasonryResizeStaysInColumn(void)
+{
+    CGSize sizes[] = {{0, 100}, {0, 50}, {0, 80}, {0, 30}, {0, 60}, {0, 10}};
+    MasonryLayoutProvider *masonry = [[MasonryLayoutProvider alloc] init];
+    masonry.minimumItemWidth = 100;
+    [masonry prepareWithSizes:sizes count:6 viewport:CGSizeMake(300, 600)];
+
+    SCVAssert([masonry setSize:CGSizeMake(0, 70) atIndex:1]);
+    SCVAssertRectEqual([masonry frameForItemAtIndex:3], CGRectMake(100, 70, 100, 30));
+    SCVAssertRectEqual([masonry frameForItemAtIndex:4], CGRectMake(100, 100, 100, 60));
+    SCVAssertRectEqual([masonry frameForItemAtIndex:5], CGRectMake(200, 80, 100, 10)); // Other columns stay
+    SCVAssert(![masonry setSize:CGSizeMake(0, 70) atIndex:1]);
+}
+
+static void testMasonryRectQueries(void)
+{
+    CGSize sizes[300];
+    for (NSInteger i = 0; i < 300; i++) {
+        sizes[i] = CGSizeMake(0, 40 + (i * 29) % 120);
+    }
+    MasonryLayoutProvider *masonry = [[MasonryLayoutProvider alloc] init];
+    masonry.minimumItemWidth = 120;
+    [masonry prepareWithSizes:sizes count:300 viewport:CGSizeMake(390, 800)];
+    SCVAssertRectQueriesMatchFrames(masonry);
+}
+
+int main(void)
+{
+    SCVRunTest(testHorizontalGridFrames);
+    SCVRunTest(testHorizontalGridResize);
+    SCVRunTest(testHorizontalGridRectQueries);
+    SCVRunTest(testVerticalGridFrames);
+    SCVRunTest(testVerticalGridRectQueries);
+    SCVRunTest(testMasonryPlacement);
+    SCVRunTest(testMasonryAppendKeepsFrames);
+    SCVRunTest(testMasonryResizeStaysInColumn);
+    SCVRunTest(testMasonryRectQueries);
+    return SCVTestResult();
+}
@@ -0,0 +1,77 @@
+#import "SCVTestSupport.h"
+#import "SmartCollectionViewMaxTree.h"
+
+static void testMaxValue(void)
+{
+    CGFloat values[] = {3, 9, 4, 1, 7};
+    SmartCollectionViewMaxTree *tree = [[SmartCollectionViewMaxTree alloc] init];
+    SCVAssertClose(tree.maxValue, 0);
+
+    [tree resetWithValues:values count:5];
+    SCVAssertEqual(tree.count, 5);
+    SCVAssertClose(tree.maxValue, 9);
+    SCVAssertClose([tree valueAtIndex:4], 7);
+    SCVAssertClose([tree valueAtIndex:5], 0); // Out of range
+}
+
+static void testPointUpdates(void)
+{
+    CGFloat values[] = {3, 9, 4, 1, 7};
+    SmartCollectionViewMaxTree *tree = [[SmartCollectionViewMaxTree alloc] init];
+    [tree resetWithValues:values count:5];
+
+    SCVAssert(![tree setValue:4 atIndex:2], @"unchanged value reports no change");
+    SCVAssert(![tree setValue:100 atIndex:5], @"out of range is ignored");
+
+    SCVAssert([tree setValue:2 atIndex:1]); // Lowering the max falls back to the next largest
+    SCVAssertClose(tree.maxValue, 7);
+    SCVAssert([tree setValue:12 atIndex:3]);
+    SCVAssertClose(tree.maxValue, 12);
+    SCVAssertClose([tree valueAtIndex:3], 12);
+}
+
+static void testMatchesLinearScan(void)
+{
+    const NSInteger count = 300; // Not a power of two
+    CGFloat values[300];
+    for (NSInteger i = 0; i < count; i++) {
+        values[i] = (i * 37) % 101;
+    }
+    SmartCollectionViewMaxTree *tree = [[SmartCollectionViewMaxTree alloc] init];
+    [tree resetWithValues:values count:count];
+
+    for (NSInteger step = 0; step < 1000; step++) {
+        NSInteger index = (step * 53) % count;
+        values[index] = (step * 29) % 113;
+        [tree setValue:values[index] atIndex:index];
+
+        CGFloat expected = 0;
+        for (NSInteger i = 0; i < count; i++) {
+            expected = MAX(expected, values[i]);
+        }
+        SCVAssertClose(tree.maxValue, expected);
+    }
+}
+
+static void testSingleValueAndRemoveAll(void)
+{
+    CGFloat value = 5;
+    SmartCollectionViewMaxTree *tree = [[SmartCollectionViewMaxTree alloc] init];
+    [tree resetWithValues:&value count:1];
+    SCVAssertClose(tree.maxValue, 5);
+    SCVAssert([tree setValue:2 atIndex:0]);
+    SCVAssertClose(tree.maxValue, 2);
+
+    [tree removeAll];
+    SCVAssertEqual(tree.count, 0);
+    SCVAssertClose(tree.maxValue, 0);
+}
+
+int main(void)
+{
+    SCVRunTest(testMaxValue);
+    SCVRunTest(testPointUpdates);
+    SCVRunTest(testMatchesLinearScan);
+    SCVRunTest(testSingleValueAndRemoveAll);
+    return SCVTestResult();
+}
@@ -0,0 +1,94 @@
+#import "SCVTestSupport.h"
+#import "SmartCollectionViewOffsetIndex.h"
+
+static void testPrefixOffsets(void)
+{
+    CGFloat lengths[] = {10, 20, 30, 40};
+    SmartCollectionViewOffsetIndex *index = [[SmartCollectionViewOffsetIndex alloc] init];
+    [index resetWithLengths:lengths count:4];
+
+    SCVAssertEqual(index.count, 4);
+    SCVAssertClose(index.totalLength, 100);
+    SCVAssertClose([index offsetAtIndex:0], 0);
+    SCVAssertClose([index offsetAtIndex:2], 30);
+    SCVAssertClose([index offsetAtIndex:4], 100);
+    SCVAssertClose([index endOffsetAtIndex:1], 30);
+    SCVAssertClose([index lengthAtIndex:3], 40);
+}
+
+static void testIndexForOffset(void)
+{
+    CGFloat lengths[] = {10, 20, 30, 40};
+    SmartCollectionViewOffsetIndex *index = [[SmartCollectionViewOffsetIndex alloc] init];
+    [index resetWithLengths:lengths count:4];
+
+    SCVAssertEqual([index indexForOffset:0], 0);
+    SCVAssertEqual([index indexForOffset:9.5], 0);
+    SCVAssertEqual([index indexForOffset:10], 1); // End offset of item 0 is not inside it
+    SCVAssertEqual([index indexForOffset:59], 2);
+    SCVAssertEqual([index indexForOffset:99], 3);
+    SCVAssertEqual([index indexForOffset:100], 4);
+    SCVAssertEqual([index indexForOffset:500], 4);
+}
+
+static void testPointUpdate(void)
+{
+    CGFloat lengths[] = {10, 20, 30, 40};
+    SmartCollectionViewOffsetIndex *index = [[SmartCollectionViewOffsetIndex alloc] init];
+    [index resetWithLengths:lengths count:4];
+    NSUInteger mutations = index.mutationCount;
+
+    SCVAssert(![index setLength:20 atIndex:1], @"unchanged length reports no change");
+    SCVAssertEqual(index.mutationCount, mutations);
+
+    SCVAssert([index setLength:25 atIndex:1]);
+    SCVAssert(index.mutationCount != mutations);
+    SCVAssertClose([index offsetAtIndex:1], 10);
+    SCVAssertClose([index offsetAtIndex:2], 35);
+    SCVAssertClose([index offsetAtIndex:3], 65);
+    SCVAssertClose(index.totalLength, 105);
+    SCVAssertEqual([index indexForOffset:34], 1);
+}
+
+static void testAppendMatchesReset(void)
+{
+    const NSInteger count = 1000;
+    CGFloat *lengths = malloc(sizeof(CGFloat) * count);
+    SmartCollectionViewOffsetIndex *appended = [[SmartCollectionViewOffsetIndex alloc] init];
+    for (NSInteger i = 0; i < count; i++) {
+        lengths[i] = 1 + (i * 7) % 13;
+        [appended appendLength:lengths[i]];
+    }
+    SmartCollectionViewOffsetIndex *reset = [[SmartCollectionViewOffsetIndex alloc] init];
+    [reset resetWithLengths:lengths count:count];
+
+    CGFloat offset = 0;
+    for (NSInteger i = 0; i < count; i++) {
+        SCVAssertClose([appended offsetAtIndex:i], offset);
+        SCVAssertClose([reset offsetAtIndex:i], offset);
+        offset += lengths[i];
+    }
+    SCVAssertClose(appended.totalLength, offset);
+    free(lengths);
+}
+
+static void testRemoveAll(void)
+{
+    SmartCollectionViewOffsetIndex *index = [[SmartCollectionViewOffsetIndex alloc] init];
+    [index appendLength:10];
+    [index removeAll];
+
+    SCVAssertEqual(index.count, 0);
+    SCVAssertClose(index.totalLength, 0);
+    SCVAssertEqual([index indexForOffset:5], 0);
+}
+
+int main(void)
+{
+    SCVRunTest(testPrefixOffsets);
+    SCVRunTest(testIndexForOffset);
+    SCVRunTest(testPointUpdate);
+    SCVRunTest(testAppendMatchesReset);
+    SCVRunTest(testRemoveAll);
+    return SCVTestResult();
+}
@@ -0,0 +1,106 @@
+#import "SCVTestSupport.h"
+#import "SmartCollectionViewOffsetIndex.h"
+#import "SmartCollectionViewRangeTracker.h"
+
+// The range a fresh offset-index search gives, as the scheduler computes it
+static NSRange SCVSearchRange(SmartCollectionViewOffsetIndex *index, CGFloat startOffset, CGFloat endOffset)
+{
+    NSInteger count = index.count;
+    NSInteger startIndex = MIN([index indexForOffset:startOffset], count - 1);
+    NSInteger endIndex = [index indexForOffset:endOffset];
+    if (endIndex < count && [index offsetAtIndex:endIndex] < endOffset) {
+        endIndex += 1;
+    }
+    endIndex = MAX(startIndex, MIN(endIndex, count));
+    return NSMakeRange(startIndex, endIndex - startIndex);
+}
+
+static SmartCollectionViewOffsetIndex *SCVMakeIndex(NSInteger count)
+{
+    CGFloat *lengths = malloc(sizeof(CGFloat) * count);
+    for (NSInteger i = 0; i < count; i++) {
+        lengths[i] = 20 + (i * 17) % 61;
+    }
+    SmartCollectionViewOffsetIndex *index = [[SmartCollectionViewOffsetIndex alloc] init];
+    [index resetWithLengths:lengths count:count];
+    free(lengths);
+    return index;
+}
+
+static void testUniformRanges(void)
+{
+    CGFloat lengths[100];
+    for (NSInteger i = 0; i < 100; i++) {
+        lengths[i] = 10;
+    }
+    SmartCollectionViewOffsetIndex *index = [[SmartCollectionViewOffsetIndex alloc] init];
+    [index resetWithLengths:lengths count:100];
+    SmartCollectionViewRangeTracker *tracker = [[SmartCollectionViewRangeTracker alloc] initWithOffsetIndex:index];
+
+    SCVAssertRangeEqual([tracker rangeForStartOffset:0 endOffset:50 changed:NULL], NSMakeRange(0, 5));
+    SCVAssertRangeEqual([tracker rangeForStartOffset:5 endOffset:55 changed:NULL], NSMakeRange(0, 6));
+    SCVAssertRangeEqual([tracker rangeForStartOffset:10 endOffset:60 changed:NULL], NSMakeRange(1, 5));
+    SCVAssertRangeEqual([tracker rangeForStartOffset:980 endOffset:1030 changed:NULL], NSMakeRange(98, 2));
+}
+
+static void testChangedFlag(void)
+{
+    SmartCollectionViewOffsetIndex *index = SCVMakeIndex(50);
+    SmartCollectionViewRangeTracker *tracker = [[SmartCollectionViewRangeTracker alloc] initWithOffsetIndex:index];
+
+    BOOL changed = NO;
+    [tracker rangeForStartOffset:0 endOffset:200 changed:&changed];
+    SCVAssert(changed, @"first lookup reports a change");
+    [tracker rangeForStartOffset:0.5 endOffset:200.5 changed:&changed];
+    SCVAssert(!changed, @"sub-item scroll keeps the range");
+}
+
+static void testScrollMatchesSearch(void)
+{
+    SmartCollectionViewOffsetIndex *index = SCVMakeIndex(2000);
+    SmartCollectionViewRangeTracker *tracker = [[SmartCollectionViewRangeTracker alloc] initWithOffsetIndex:index];
+    const CGFloat viewport = 600;
+
+    // Small steps gallop; the occasional jump falls back to a search
+    CGFloat offset = 0;
+    for (NSInteger step = 0; step < 3000; step++) {
+        CGFloat delta = (step % 97 == 0) ? 9000 : 7 + (step % 5) * 11;
+        offset = fmod(offset + delta, index.totalLength);
+        NSRange range = [tracker rangeForStartOffset:offset endOffset:offset + viewport changed:NULL];
+        SCVAssertRangeEqual(range, SCVSearchRange(index, offset, offset + viewport));
+    }
+    // And back up again
+    for (NSInteger step = 0; step < 500; step++) {
+        offset = MAX(0, offset - 13);
+        NSRange range = [tracker rangeForStartOffset:offset endOffset:offset + viewport changed:NULL];
+        SCVAssertRangeEqual(range, SCVSearchRange(index, offset, offset + viewport));
+    }
+}
+
+static void testMutationReseeks(void)
+{
+    SmartCollectionViewOffsetIndex *index = SCVMakeIndex(100);
+    SmartCollectionViewRangeTracker *tracker = [[SmartCollectionViewRangeTracker alloc] initWithOffsetIndex:index];
+    [tracker rangeForStartOffset:1000 endOffset:1400 changed:NULL];
+
+    [index setLength:900 atIndex:3]; // Everything after item 3 moves down
+    NSRange range = [tracker rangeForStartOffset:1000 endOffset:1400 changed:NULL];
+    SCVAssertRangeEqual(range, SCVSearchRange(index, 1000, 1400));
+}
+
+static void testEmptyIndex(void)
+{
+    SmartCollectionViewOffsetIndex *index = [[SmartCollectionViewOffsetIndex alloc] init];
+    SmartCollectionViewRangeTracker *tracker = [[SmartCollectionViewRangeTracker alloc] initWithOffsetIndex:index];
+    SCVAssertRangeEqual([tracker rangeForStartOffset:0 endOffset:100 changed:NULL], NSMakeRange(0, 0));
+}
+
+int main(void)
+{
+    SCVRunTest(testUniformRanges);
+    SCVRunTest(testChangedFlag);
+    SCVRunTest(testScrollMatchesSearch);
+    SCVRunTest(testMutationReseeks);
+    SCVRunTest(testEmptyIndex);
+    return SCVTestResult();
+}
@@ -0,0 +1,42 @@
+#import <Foundation/Foundation.h>
+#import <CoreGraphics/CoreGraphics.h>
+#import <math.h>
+
+// Minimal assertions for the core tests: a failure is logged and the
+// process exits non-zero at the end, so ctest reports the executable as failed.
+
+static int SCVTestFailures = 0;
+
+#define SCVAssert(condition, ...) do { \
+    if (!(condition)) { \
+        SCVTestFailures++; \
+        NSLog(@"%s:%d: assertion failed: %s %@", __FILE__, __LINE__, #condition, [NSString stringWithFormat:@"" __VA_ARGS__]); \
+    } \
+} while (0)
+
+#define SCVAssertEqual(actual, expected) \
+    SCVAssert((actual) == (expected), @"got %@, expected %@", @(actual), @(expected))
+
+#define SCVAssertClose(actual, expected) \
+    SCVAssert(fabs((double)(actual) - (double)(expected)) < 1e-6, @"got %f, expected %f", (double)(actual), (double)(expected))
+
+#define SCVAssertRectEqual(actual, expected) \
+    SCVAssert(CGRectEqualToRect((actual), (expected)), @"got {%g, %g, %g, %g}, expected {%g, %g, %g, %g}", \
+              (actual).origin.x, (actual).origin.y, (actual).size.width, (actual).size.height, \
+              (expected).origin.x, (expected).origin.y, (expected).size.width, (expected).size.height)
+
+#define SCVAssertRangeEqual(actual, expected) \
+    SCVAssert(NSEqualRanges((actual), (expected)), @"got %@, expected %@", NSStringFromRange(actual), NSStringFromRange(expected))
+
+#define SCVRunTest(test) do { \
+    @autoreleasepool { \
+        int failuresBefore = SCVTestFailures; \
+        test(); \
+        NSLog(@"%s %s", SCVTestFailures == failuresBefore ? "PASS" : "FAIL", #test); \
+    } \
+} while (0)
+
+static inline int SCVTestResult(void)
+{
+    return SCVTestFailures == 0 ? 0 : 1;
+}
@@ -0,0 +1,102 @@
+#import "SCVTestSupport.h"
+#import "SmartCollectionViewOffsetIndex.h"
+#import "SmartCollectionViewSectionIndex.h"
+
+// Ten items of length 10; sections start at items 2 and 5
+static SmartCollectionViewOffsetIndex *SCVMakeItems(void)
+{
+    CGFloat lengths[10];
+    for (NSInteger i = 0; i < 10; i++) {
+        lengths[i] = 10;
+    }
+    SmartCollectionViewOffsetIndex *items = [[SmartCollectionViewOffsetIndex alloc] init];
+    [items resetWithLengths:lengths count:10];
+    return items;
+}
+
+static SmartCollectionViewSectionIndex *SCVMakeSections(SmartCollectionViewOffsetIndex *items)
+{
+    NSMutableIndexSet *headers = [NSMutableIndexSet indexSetWithIndex:2];
+    [headers addIndex:5];
+    SmartCollectionViewSectionIndex *sections = [[SmartCollectionViewSectionIndex alloc] init];
+    sections.headerIndices = headers;
+    [sections updateWithItemOffsets:items];
+    return sections;
+}
+
+static void testSectionForOffset(void)
+{
+    SmartCollectionViewSectionIndex *sections = SCVMakeSections(SCVMakeItems());
+
+    SCVAssertEqual(sections.sectionCount, 2);
+    SCVAssertEqual([sections sectionForOffset:10], NSNotFound); // Before the first header
+    SCVAssertEqual([sections sectionForOffset:20], 0);
+    SCVAssertEqual([sections sectionForOffset:49], 0);
+    SCVAssertEqual([sections sectionForOffset:50], 1);
+    SCVAssertEqual([sections sectionForOffset:500], 1);
+    SCVAssertClose([sections startOffsetOfSection:0], 20);
+    SCVAssertClose([sections endOffsetOfSection:0], 50);
+    SCVAssertClose([sections endOffsetOfSection:1], 100);
+}
+
+static void testSectionForItem(void)
+{
+    SmartCollectionViewSectionIndex *sections = SCVMakeSections(SCVMakeItems());
+
+    SCVAssertEqual([sections sectionForItemAtIndex:1], NSNotFound);
+    SCVAssertEqual([sections sectionForItemAtIndex:2], 0);
+    SCVAssertEqual([sections sectionForItemAtIndex:4], 0);
+    SCVAssertEqual([sections sectionForItemAtIndex:5], 1);
+    SCVAssertEqual([sections sectionForItemAtIndex:9], 1);
+    SCVAssertEqual([sections headerIndexForSection:1], 5);
+    SCVAssertEqual([sections headerIndexForSection:2], NSNotFound);
+}
+
+static void testPinnedOffset(void)
+{
+    SmartCollectionViewSectionIndex *sections = SCVMakeSections(SCVMakeItems());
+
+    // Never before its own position, at the leading edge mid-section, pushed back at the end
+    SCVAssertClose([sections pinnedOffsetForSection:0 scrollOffset:10 headerLength:10], 20);
+    SCVAssertClose([sections pinnedOffsetForSection:0 scrollOffset:30 headerLength:10], 30);
+    SCVAssertClose([sections pinnedOffsetForSection:0 scrollOffset:45 headerLength:10], 40);
+}
+
+static void testFollowsItemOffsets(void)
+{
+    SmartCollectionViewOffsetIndex *items = SCVMakeItems();
+    SmartCollectionViewSectionIndex *sections = SCVMakeSections(items);
+
+    [items setLength:30 atIndex:3];
+    [sections updateWithItemOffsets:items];
+    SCVAssertClose([sections endOffsetOfSection:0], 70);
+    SCVAssertClose([sections startOffsetOfSection:1], 70);
+    SCVAssertEqual([sections sectionForOffset:65], 0);
+}
+
+static void testHeadersPastItemsAreIgnored(void)
+{
+    SmartCollectionViewOffsetIndex *items = SCVMakeItems();
+    NSMutableIndexSet *headers = [NSMutableIndexSet indexSetWithIndex:2];
+    [headers addIndex:20];
+    SmartCollectionViewSectionIndex *sections = [[SmartCollectionViewSectionIndex alloc] init];
+    sections.headerIndices = headers;
+    [sections updateWithItemOffsets:items];
+
+    SCVAssertEqual(sections.sectionCount, 1);
+    SCVAssertClose([sections endOffsetOfSection:0], 100);
+
+    [sections removeAll];
+    SCVAssertEqual(sections.sectionCount, 0);
+    SCVAssertEqual([sections sectionForOffset:50], NSNotFound);
+}
+
+int main(void)
+{
+    SCVRunTest(testSectionForOffset);
+    SCVRunTest(testSectionForItem);
+    SCVRunTest(testPinnedOffset);
+    SCVRunTest(testFollowsItemOffsets);
+    SCVRunTest(testHeadersPastItemsAreIgnored);
+    return SCVTestResult();
+}
@@ -1,8 +1,14 @@
-import React, { useState, useCallback, useEffect } from 'react';
-import { requireNativeComponent, ViewStyle, NativeSyntheticEvent, View } from 'react-native';
+import React, { useState, useCallback, useEffect, useMemo, useRef } from 'react';
+import { requireNativeComponent, ViewStyle, StyleProp, NativeSyntheticEvent, StyleSheet, LayoutChangeEvent } from 'react-native';
 
 interface RequestItemsEvent {
   indices: number[];
+  generation: number;
+}
+
+interface CancelRequestsEvent {
+  indices: number[];
+  generation: number; // Latest request generation at the time of cancellation
 }
 
 interface VisibleRangeChangeEvent {
@@ -26,6 +32,22 @@ interface SmartCollectionViewNativeProps {
   overscanCount?: number;
   overscanLength?: number;
   shadowBufferMultiplier?: number; // Multiplier for request range beyond mount range (default: 2.0)
+  predictiveWindowing?: boolean; // Skew mount/request windows toward the scroll direction (default: false)
+  maxVisibleRequestsPerBatch?: number; // Per-batch cap for visible items (default: 0 = no lane cap)
+  maxMountBufferRequestsPerBatch?: number; // Per-batch cap for mount-buffer items (default: 0 = no lane cap)
+  maxShadowRequestsPerBatch?: number; // Per-batch cap for shadow-buffer items (default: 0 = no lane cap)
+  adaptiveBatching?: boolean; // Size batches from measured mount cost (default: false)
+  frameBudget?: number; // Milliseconds of mount work per frame in adaptive mode (default: 4)
+  itemTypes?: string[]; // Item type per index; keys the native per-type cost model
+  itemKeys?: string[]; // Stable key per index; measured sizes are cached by key, not position
+  persistentSizeCacheName?: string; // Keep keyed sizes on disk across launches under this name
+  adaptiveShadowBuffer?: boolean; // Size the leading shadow buffer from measured JS render latency (default: false)
+  maxOutstandingRequests?: number; // Requested-but-unrendered items allowed at once (default: 0 = no flow control)
+  acknowledgedGeneration?: number; // Latest onRequestItems generation rendered by JS
+  unmountDwellTime?: number; // Milliseconds an item stays outside the exit band before unmounting (default: 0)
+  visibleLayoutCacheBudget?: number; // KB of cached frames for the visible tier (default: 0 = unlimited)
+  bufferLayoutCacheBudget?: number; // KB of cached frames for the buffer tier (default: 0 = unlimited)
+  coldLayoutCacheBudget?: number; // KB of cached frames for the cold tier (default: 0 = unlimited)
   initialMaxToRenderPerBatch?: number; // Optional: override maxToRenderPerBatch during initial mount
   initialOverscanCount?: number; // Optional: override overscanCount during initial mount
   initialOverscanLength?: number; // Optional: override overscanLength during initial mount
@@ -33,10 +55,15 @@ interface SmartCollectionViewNativeProps {
   
   // Layout
   horizontal?: boolean;
+  layoutType?: 'list' | 'grid' | 'masonry';
+  rowCount?: number;
+  minimumItemWidth?: number;
+  stickyHeaderIndices?: number[];
   estimatedItemSize?: {width: number, height: number};
   
   // Events
   onRequestItems?: (event: NativeSyntheticEvent<RequestItemsEvent>) => void;
+  onCancelRequests?: (event: NativeSyntheticEvent<CancelRequestsEvent>) => void;
   onVisibleRangeChange?: (event: NativeSyntheticEvent<VisibleRangeChangeEvent>) => void;
   onScroll?: (event: NativeSyntheticEvent<ScrollEvent>) => void;
   onScrollBeginDrag?: (event: NativeSyntheticEvent<ScrollEvent>) => void;
@@ -46,11 +73,22 @@ interface SmartCollectionViewNativeProps {
   onScrollEndDecelerating?: (event: NativeSyntheticEvent<ScrollEvent>) => void;
   
   style?: ViewStyle;
+  onLayout?: (event: LayoutChangeEvent) => void;
+}
+
+// Wrapper around each rendered item; native places it by itemIndex, not by child position
+interface SmartCollectionViewItemNativeProps {
+  itemIndex: number;
+  style?: StyleProp<ViewStyle>;
+  children?: React.ReactNode;
 }
 
 interface SmartCollectionViewProps {
   data: any[];
   renderItem: (info: {item: any, index: number}) => React.ReactElement;
+  getItemType?: (item: any, index: number) => string; // Optional: groups items with similar mount cost
+  keyExtractor?: (item: any, index: number) => string; // Optional: stable identity so inserts/removes keep measured sizes
+  persistentSizeCacheName?: string;   // Optional: persist measured sizes across launches (needs keyExtractor)
   
   // Virtualization controls
   initialNumToRender?: number;        // Default: 10
@@ -58,6 +96,18 @@ interface SmartCollectionViewProps {
   overscanCount?: number;             // Items before/after viewport, default: 5
   overscanLength?: number;            // Alternative: in screen widths/heights, default: 1.0
   shadowBufferMultiplier?: number;    // Multiplier for request range beyond mount range, default: 2.0
+  predictiveWindowing?: boolean;      // Skew windows toward scroll direction based on velocity, default: false
+  maxVisibleRequestsPerBatch?: number;     // Optional: cap visible-item requests per batch
+  maxMountBufferRequestsPerBatch?: number; // Optional: cap mount-buffer requests per batch
+  maxShadowRequestsPerBatch?: number;      // Optional: cap shadow-buffer requests per batch
+  adaptiveBatching?: boolean;         // Adapt batch size to measured mount cost, default: false
+  frameBudget?: number;               // ms of mount work per frame when adaptive, default: 4
+  adaptiveShadowBuffer?: boolean;     // Request ahead by measured render latency x velocity, default: false
+  maxOutstandingRequests?: number;    // Cap on requested-but-unrendered items (backpressure), default: 0 = off
+  unmountDwellTime?: number;          // ms outside the exit band before an item unmounts, default: 0
+  visibleLayoutCacheBudget?: number;  // Optional: KB of cached frames kept for visible items
+  bufferLayoutCacheBudget?: number;   // Optional: KB of cached frames kept for the buffer
+  coldLayoutCacheBudget?: number;     // Optional: KB of cached frames kept beyond the buffer
   initialMaxToRenderPerBatch?: number; // Optional: override maxToRenderPerBatch during initial mount
   initialOverscanCount?: number;      // Optional: override overscanCount during initial mount
   initialOverscanLength?: number;     // Optional: override overscanLength during initial mount
@@ -65,10 +115,15 @@ interface SmartCollectionViewProps {
   
   // Layout
   horizontal?: boolean;
+  layoutType?: 'list' | 'grid' | 'masonry'; // 'grid' fills rows or columns; 'masonry' (vertical) fills the shortest column, default: 'list'
+  rowCount?: number;                  // Rows of a horizontal grid, default: 2
+  minimumItemWidth?: number;          // Vertical grids and masonry fit as many columns of this width as they can, default: estimatedItemSize.width
+  stickyHeaderIndices?: number[];     // Items that start a section and pin to the leading edge while it scrolls past (lists only)
   estimatedItemSize?: {width: number, height: number};
   
   // Events
   onRequestItems?: (event: NativeSyntheticEvent<RequestItemsEvent>) => void;
+  onCancelRequests?: (event: NativeSyntheticEvent<CancelRequestsEvent>) => void;
   onVisibleRangeChange?: (event: NativeSyntheticEvent<VisibleRangeChangeEvent>) => void;
   onScroll?: (event: NativeSyntheticEvent<ScrollEvent>) => void;
   onScrollBeginDrag?: (event: NativeSyntheticEvent<ScrollEvent>) => void;
@@ -84,23 +139,44 @@ interface SmartCollectionViewProps {
 }
 
 const SmartCollectionViewNative = requireNativeComponent<SmartCollectionViewNativeProps>('SmartCollectionView');
+const SmartCollectionViewItemNative = requireNativeComponent<SmartCollectionViewItemNativeProps>('SmartCollectionViewItem');
 
 const SmartCollectionView: React.FC<SmartCollectionViewProps> = ({
   data,
   renderItem,
+  getItemType,
+  keyExtractor,
+  persistentSizeCacheName,
   initialNumToRender = 2,
   maxToRenderPerBatch = 1,
   overscanCount = 1,
   overscanLength = 2,
   shadowBufferMultiplier = 2.0,
+  predictiveWindowing = false,
+  maxVisibleRequestsPerBatch,
+  maxMountBufferRequestsPerBatch,
+  maxShadowRequestsPerBatch,
+  adaptiveBatching = false,
+  frameBudget = 4,
+  adaptiveShadowBuffer = false,
+  maxOutstandingRequests = 0,
+  unmountDwellTime = 0,
+  visibleLayoutCacheBudget,
+  bufferLayoutCacheBudget,
+  coldLayoutCacheBudget,
   initialMaxToRenderPerBatch,
   initialOverscanCount,
   initialOverscanLength,
   initialShadowBufferMultiplier,
   horizontal = true,
+  layoutType = 'list',
+  rowCount = 2,
+  minimumItemWidth,
+  stickyHeaderIndices,
   estimatedItemSize = {width: 100, height: 80},
   useFlatList = false,
   onRequestItems,
+  onCancelRequests,
   onVisibleRangeChange,
   onScroll,
   onScrollBeginDrag,
@@ -117,36 +193,119 @@ const SmartCollectionView: React.FC<SmartCollectionViewProps> = ({
     return Array.from({ length: count }, (_, i) => i);
   });
   
-  // Reset when data changes
+  // Keys travel to native as a flat array aligned with data
+  const itemKeys = useMemo(
+    () => (keyExtractor ? data.map((item, index) => keyExtractor(item, index)) : undefined),
+    [data, keyExtractor],
+  );
+  const previousItemKeys = useRef(itemKeys);
+  
+  // Reset when data changes; keyed data keeps its rendered items, moved to their new indices
   useEffect(() => {
+    const previousKeys = previousItemKeys.current;
+    previousItemKeys.current = itemKeys;
+    if (itemKeys && previousKeys) {
+      if (previousKeys !== itemKeys) {
+        const indexByKey = new Map(itemKeys.map((key, index) => [key, index]));
+        setRenderedIndices(prev => prev
+          .map(index => indexByKey.get(previousKeys[index]))
+          .filter((index): index is number => index !== undefined)
+          .sort((a, b) => a - b));
+      }
+      return;
+    }
     const count = Math.min(initialNumToRender, data.length);
     setRenderedIndices(Array.from({ length: count }, (_, i) => i));
-  }, [data.length, initialNumToRender]);
+  }, [data.length, initialNumToRender, itemKeys]);
+  
+  // Indices whose children are committed to native; cancellations never withdraw these
+  const committedIndices = useRef<Set<number>>(new Set());
+  useEffect(() => {
+    committedIndices.current = new Set(renderedIndices);
+  }, [renderedIndices]);
+  
+  // Native asks again for a committed index only when its child never registered
+  // (the request expired); a fresh key remounts that child instead of keeping the lost one
+  const remountCounts = useRef<Map<string | number, number>>(new Map());
+  
+  // Latest request batch rendered; acknowledged back to native for flow control
+  const [acknowledgedGeneration, setAcknowledgedGeneration] = useState(0);
+  
+  // Item types travel to native as a flat array aligned with data
+  const itemTypes = useMemo(
+    () => (getItemType ? data.map((item, index) => getItemType(item, index)) : undefined),
+    [data, getItemType],
+  );
   
   // Handle native request for more items
   const handleRequestItems = useCallback((event: NativeSyntheticEvent<RequestItemsEvent>) => {
-    const { indices } = event.nativeEvent;
+    const { indices, generation } = event.nativeEvent;
+    indices
+      .filter(index => committedIndices.current.has(index))
+      .forEach(index => {
+        const key = itemKeys ? itemKeys[index] : index;
+        remountCounts.current.set(key, (remountCounts.current.get(key) ?? 0) + 1);
+      });
     setRenderedIndices(prev => {
       const newSet = new Set([...prev, ...indices]);
       return Array.from(newSet).sort((a, b) => a - b);
     });
+    // Committed together with the new children, so native sees the ack once the batch is rendered
+    setAcknowledgedGeneration(prev => Math.max(prev, generation));
     
     // Call user's handler if provided
     if (onRequestItems) {
       onRequestItems(event);
     }
-  }, [onRequestItems]);
+  }, [onRequestItems, itemKeys]);
+  
+  // Native withdrew requests that scrolled out of the window before they rendered.
+  // Only still-pending indices are dropped; a child that already rendered stays mounted
+  // so native never loses an index it has placed
+  const handleCancelRequests = useCallback((event: NativeSyntheticEvent<CancelRequestsEvent>) => {
+    const cancelled = new Set(
+      event.nativeEvent.indices.filter(index => !committedIndices.current.has(index)),
+    );
+    if (cancelled.size > 0) {
+      setRenderedIndices(prev => prev.filter(index => !cancelled.has(index)));
+    }
+    
+    if (onCancelRequests) {
+      onCancelRequests(event);
+    }
+  }, [onCancelRequests]);
+  
+  // Vertical grid and masonry cells render at the column width native derives from the list width
+  const isVerticalGrid = (layoutType === 'grid' || layoutType === 'masonry') && !horizontal;
+  const [listWidth, setListWidth] = useState(0);
+  const handleLayout = useCallback((event: LayoutChangeEvent) => {
+    setListWidth(event.nativeEvent.layout.width);
+  }, []);
+  const columnWidth = useMemo(() => {
+    if (!isVerticalGrid || listWidth <= 0) {
+      return undefined;
+    }
+    const minimumWidth = Math.max(1, minimumItemWidth ?? estimatedItemSize.width);
+    return listWidth / Math.max(1, Math.floor(listWidth / minimumWidth));
+  }, [isVerticalGrid, listWidth, minimumItemWidth, estimatedItemSize.width]);
   
   // Only render items whose indices are in renderedIndices
-  // Wrap each item in an absolute-positioned View so they don't affect parent layout
+  // Wrap each item in an absolute-positioned item view so they don't affect parent layout;
+  // it tells native which index the item is, since rendered indices have gaps.
+  // Rows of a vertical list stretch to the list width
+  const itemStyle = columnWidth !== undefined
+    ? [styles.item, { width: columnWidth }]
+    : horizontal || isVerticalGrid ? styles.item : styles.rowItem;
   const itemsToRender = renderedIndices
     .filter(index => index >= 0 && index < data.length)
     .map(index => {
       const item = renderItem({ item: data[index], index });
+      const key = itemKeys ? itemKeys[index] : index;
+      const remounts = remountCounts.current.get(key);
       return (
-        <View key={index} style={{ position: 'absolute' }}>
+        <SmartCollectionViewItemNative key={remounts ? `${key}#${remounts}` : key} itemIndex={index} style={itemStyle}>
           {item}
-        </View>
+        </SmartCollectionViewItemNative>
       );
     });
   
@@ -157,13 +316,34 @@ const SmartCollectionView: React.FC<SmartCollectionViewProps> = ({
     overscanCount,
     overscanLength,
     shadowBufferMultiplier,
+    predictiveWindowing,
+    ...(maxVisibleRequestsPerBatch !== undefined && { maxVisibleRequestsPerBatch }),
+    ...(maxMountBufferRequestsPerBatch !== undefined && { maxMountBufferRequestsPerBatch }),
+    ...(maxShadowRequestsPerBatch !== undefined && { maxShadowRequestsPerBatch }),
+    adaptiveBatching,
+    frameBudget,
+    ...(itemTypes !== undefined && { itemTypes }),
+    ...(itemKeys !== undefined && { itemKeys }),
+    ...(persistentSizeCacheName !== undefined && { persistentSizeCacheName }),
+    adaptiveShadowBuffer,
+    maxOutstandingRequests,
+    acknowledgedGeneration,
+    unmountDwellTime,
+    ...(visibleLayoutCacheBudget !== undefined && { visibleLayoutCacheBudget }),
+    ...(bufferLayoutCacheBudget !== undefined && { bufferLayoutCacheBudget }),
+    ...(coldLayoutCacheBudget !== undefined && { coldLayoutCacheBudget }),
     ...(initialMaxToRenderPerBatch !== undefined && { initialMaxToRenderPerBatch }),
     ...(initialOverscanCount !== undefined && { initialOverscanCount }),
     ...(initialOverscanLength !== undefined && { initialOverscanLength }),
     ...(initialShadowBufferMultiplier !== undefined && { initialShadowBufferMultiplier }),
     horizontal,
+    layoutType,
+    rowCount,
+    ...(minimumItemWidth !== undefined && { minimumItemWidth }),
+    ...(stickyHeaderIndices !== undefined && { stickyHeaderIndices }),
     estimatedItemSize,
     onRequestItems: handleRequestItems,
+    onCancelRequests: handleCancelRequests,
     onVisibleRangeChange,
     onScroll,
     onScrollBeginDrag,
@@ -172,6 +352,7 @@ const SmartCollectionView: React.FC<SmartCollectionViewProps> = ({
     onMomentumScrollEnd,
     onScrollEndDecelerating,
     style,
+    ...(isVerticalGrid && { onLayout: handleLayout }),
     ...props,
   };
   
@@ -182,4 +363,15 @@ const SmartCollectionView: React.FC<SmartCollectionViewProps> = ({
   );
 };
 
+const styles = StyleSheet.create({
+  item: {
+    position: 'absolute',
+  },
+  rowItem: {
+    position: 'absolute',
+    left: 0,
+    right: 0,
+  },
+});
+
 export default SmartCollectionView;